@@ -0,0 +1,100 @@
+// Counts heap allocations while bulk-loading tasks. TaskManager and User
+// carve their index nodes out of a TaskArena and intern names into chunked
+// storage, so the count per thousand tasks should stay small and flat as the
+// task count grows. The legacy path (one std::make_unique<AiTask> per task)
+// and a heap-backed PriorityIndex are shown for contrast.
+//
+// Usage: benchArena [maxTasks]
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "User.h"
+#include "AiTask.h"
+#include "BenchUtil.h"
+
+namespace {
+
+std::size_t allocations = 0;
+
+void report(const char* path, std::size_t count, std::size_t allocated, double seconds) {
+    std::cout << std::left << std::setw(26) << path << std::right << std::setw(10) << count
+              << std::setw(16) << std::fixed << std::setprecision(1) << allocated * 1000.0 / count
+              << std::setw(14) << seconds * 1e9 / count << "\n";
+}
+
+}
+
+// Count every heap allocation made by the measured loops
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    std::size_t maxTasks = bench::sizeArg(argc, argv, 1, 1000000);
+
+    std::cout << std::left << std::setw(26) << "path" << std::right << std::setw(10) << "tasks"
+              << std::setw(16) << "mallocs/1k" << std::setw(14) << "ns/task" << "\n";
+    for (std::size_t count = 1000; count <= maxTasks; count *= 10) {
+        std::vector<Task> tasks;
+        tasks.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.emplace_back(TaskKind::Ai, "task-" + std::to_string(i), static_cast<int>(i % 3) + 1, 1,
+                               std::chrono::system_clock::time_point(std::chrono::hours(i % 5000)));
+        }
+
+        {
+            TaskManager manager;
+            std::size_t before = allocations;
+            bench::Timer timer;
+            for (const Task& task : tasks) {
+                manager.addTask(task);
+            }
+            report("TaskManager", count, allocations - before, timer.seconds());
+        }
+        {
+            User user("bench", "password");
+            std::size_t before = allocations;
+            bench::Timer timer;
+            for (const Task& task : tasks) {
+                user.addTask(task);
+            }
+            report("User", count, allocations - before, timer.seconds());
+        }
+        {
+            TaskManager manager;
+            std::size_t before = allocations;
+            bench::Timer timer;
+            for (const Task& task : tasks) {
+                manager.addTask(std::make_unique<AiTask>(task.name, task.priority, task.estimatedTime));
+            }
+            report("TaskManager+make_unique", count, allocations - before, timer.seconds());
+        }
+        {
+            PriorityIndex heapIndex;
+            std::size_t before = allocations;
+            bench::Timer timer;
+            for (std::size_t i = 0; i < count; ++i) {
+                heapIndex.insert(PriorityIndex::Key{tasks[i].priority, tasks[i].deadline, static_cast<TaskId>(i)}, false);
+            }
+            report("heap PriorityIndex", count, allocations - before, timer.seconds());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Measures BatchRunner replay speed on synthetic scripts: users are
+// registered, then each logs in and adds its share of tasks (runs of adds go
+// through User::addTasks), in a second run completing and updating some
+// along the way. Each script is replayed from memory and from a file on disk.
+//
+// Usage: benchBatch [commands] [users] [directory]
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "BatchRunner.h"
+#include "UserManager.h"
+#include "BinaryIO.h"
+#include "BenchUtil.h"
+
+namespace {
+
+// 'changePercent' of the commands after a user's first add are completes or
+// updates of one of its earlier tasks; the rest are adds
+std::string makeScript(std::size_t commands, std::size_t users, std::size_t changePercent) {
+    static const char* const kinds[] = {"ai", "hpc", "programming", "devops"};
+    bench::Rng rng;
+    std::string script;
+    script.reserve(commands * 48);
+    for (std::size_t u = 0; u < users; ++u) {
+        script += "register user-" + std::to_string(u) + " secret\n";
+    }
+    std::size_t perUser = commands / users;
+    for (std::size_t u = 0; u < users; ++u) {
+        script += "login user-" + std::to_string(u) + " secret\n";
+        std::size_t added = 0;
+        for (std::size_t i = 0; i < perUser; ++i) {
+            std::size_t pick = rng.below(100);
+            if (pick < changePercent && added > 0 && pick % 3 != 2) {
+                script += "complete Task " + std::to_string(rng.below(added)) + "\n";
+            } else if (pick < changePercent && added > 0) {
+                script += "update 3 2025-06-01 Task " + std::to_string(rng.below(added)) + "\n";
+            } else {
+                char line[96];
+                std::snprintf(line, sizeof(line), "add %s %d %d 2025-%02d-%02dT09:00 Task %zu\n",
+                              kinds[rng.below(4)], static_cast<int>(rng.below(3)) + 1,
+                              static_cast<int>(rng.below(40)) + 1, static_cast<int>(rng.below(12)) + 1,
+                              static_cast<int>(rng.below(28)) + 1, added++);
+                script += line;
+            }
+        }
+        script += "logout\n";
+    }
+    return script;
+}
+
+void report(const char* label, double seconds, const BatchResult& result) {
+    std::cout << std::left << std::setw(10) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << result.commands / seconds / 1e6 << " M commands/s  (" << result.commands
+              << " commands, " << result.failed << " failed)\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t commands = bench::sizeArg(argc, argv, 1, 5000000);
+    std::size_t users = bench::sizeArg(argc, argv, 2, 100);
+    std::string directory = argc > 3 ? argv[3] : "/tmp";
+
+    std::ostringstream sink;
+    for (std::size_t changePercent : {0, 7}) {
+        std::string script = makeScript(commands, users, changePercent);
+        std::cout << "adds with " << changePercent << "% completes/updates mixed in\n";
+        {
+            UserManager userManager;
+            bench::Timer timer;
+            BatchResult result = BatchRunner(userManager).runText(script, sink);
+            report("  memory", timer.seconds(), result);
+        }
+
+        std::string path = directory + "/bench_batch.txt";
+        if (!binio::writeFileAtomically(path, script)) {
+            std::cerr << "Could not write " << path << "\n";
+            return 1;
+        }
+        {
+            UserManager userManager;
+            bench::Timer timer;
+            std::FILE* in = std::fopen(path.c_str(), "rb");
+            BatchResult result = BatchRunner(userManager).run(in, sink);
+            std::fclose(in);
+            report("  file", timer.seconds(), result);
+        }
+        std::remove(path.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+// Small helpers shared by the standalone benchmarks in this directory
+namespace bench {
+
+// Wall-clock stopwatch
+class Timer {
+private:
+    std::chrono::steady_clock::time_point start;
+
+public:
+    Timer() : start(std::chrono::steady_clock::now()) {}
+
+    void reset() {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double seconds() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Deterministic xorshift generator so runs are comparable across commits
+class Rng {
+private:
+    unsigned long long state;
+
+public:
+    explicit Rng(unsigned long long seed = 88172645463325252ULL) : state(seed) {}
+
+    unsigned long long next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Uniform value in [0, bound)
+    std::size_t below(std::size_t bound) {
+        return static_cast<std::size_t>(next() % bound);
+    }
+};
+
+// Read a size argument such as "1000000" from argv, falling back to a default
+inline std::size_t sizeArg(int argc, char** argv, int index, std::size_t fallback) {
+    if (argc > index) {
+        return static_cast<std::size_t>(std::strtoull(argv[index], nullptr, 10));
+    }
+    return fallback;
+}
+
+// Keep the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}
+
+#endif
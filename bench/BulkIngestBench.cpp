@@ -0,0 +1,62 @@
+// Ingestion rate of TaskManager::addTasks against adding the same tasks one
+// at a time, both as value-type Tasks and through std::make_unique<AiTask>.
+//
+// Usage: benchBulkIngest [tasks] [distinctNames]
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "AiTask.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void report(const char* path, double seconds, std::size_t count) {
+    std::cout << std::left << std::setw(14) << path << std::right
+              << std::setw(12) << std::fixed << std::setprecision(2) << count / seconds / 1e6 << " M tasks/s"
+              << std::setw(10) << std::setprecision(2) << seconds << " s\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 10000000);
+    std::size_t distinct = bench::sizeArg(argc, argv, 2, count);
+
+    bench::Rng rng;
+    auto start = std::chrono::system_clock::now();
+    std::vector<Task> tasks;
+    tasks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        tasks.emplace_back(TaskKind::Ai, "task-" + std::to_string(i % distinct), static_cast<int>(rng.below(3)) + 1,
+                           static_cast<int>(rng.below(40)), start + std::chrono::hours(rng.below(24 * 365)));
+    }
+
+    {
+        TaskManager manager;
+        bench::Timer timer;
+        for (const Task& task : tasks) {
+            auto object = std::make_unique<AiTask>(task.name, task.priority, task.estimatedTime);
+            object->setDeadline(task.deadline);
+            manager.addTask(std::move(object));
+        }
+        report("make_unique", timer.seconds(), count);
+    }
+    {
+        TaskManager manager;
+        bench::Timer timer;
+        for (const Task& task : tasks) {
+            manager.addTask(task);
+        }
+        report("addTask", timer.seconds(), count);
+    }
+    {
+        TaskManager manager;
+        bench::Timer timer;
+        manager.addTasks(tasks);
+        report("addTasks", timer.seconds(), count);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+// Multi-threaded addTask/markTaskComplete throughput of the sharded
+// ConcurrentTaskManager versus one TaskManager behind a single mutex.
+//
+// Usage: benchConcurrent [opsPerThread] [shards]
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ConcurrentTaskManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+// Each thread alternates between adding a task and completing one it added earlier
+template <typename AddFn, typename CompleteFn>
+double run(std::size_t threads, std::size_t opsPerThread, AddFn add, CompleteFn complete) {
+    // Names are built before timing so only the manager is measured
+    std::vector<std::vector<std::string>> names(threads);
+    for (std::size_t t = 0; t < threads; ++t) {
+        for (std::size_t i = 0; i < opsPerThread / 2; ++i) {
+            names[t].push_back("t" + std::to_string(t) + "-task-" + std::to_string(i));
+        }
+    }
+
+    bench::Timer timer;
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            bench::Rng rng(t + 1);
+            const std::vector<std::string>& mine = names[t];
+            for (std::size_t i = 0; i < mine.size(); ++i) {
+                add(Task(TaskKind::Hpc, mine[i], static_cast<int>(i % 3) + 1, 1));
+                complete(mine[rng.below(i + 1)]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    return threads * (opsPerThread / 2) * 2 / timer.seconds();
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t opsPerThread = bench::sizeArg(argc, argv, 1, 1000000);
+    std::size_t shards = bench::sizeArg(argc, argv, 2, 64);
+
+    std::cout << std::setw(8) << "threads" << std::setw(18) << "sharded ops/s" << std::setw(18) << "global-lock ops/s"
+              << "\n";
+    for (std::size_t threads : {1, 2, 4, 8, 16}) {
+        ConcurrentTaskManager sharded(shards);
+        double shardedRate = run(threads, opsPerThread,
+            [&](const Task& task) { sharded.addTask(task); },
+            [&](const std::string& name) { sharded.markTaskComplete(name); });
+
+        TaskManager single;
+        std::mutex singleMutex;
+        double globalRate = run(threads, opsPerThread,
+            [&](const Task& task) {
+                std::lock_guard<std::mutex> lock(singleMutex);
+                single.addTask(task);
+            },
+            [&](const std::string& name) {
+                std::lock_guard<std::mutex> lock(singleMutex);
+                single.markTaskComplete(name);
+            });
+
+        std::cout << std::setw(8) << threads << std::fixed << std::setprecision(0)
+                  << std::setw(18) << shardedRate << std::setw(18) << globalRate << "\n";
+    }
+    return 0;
+}
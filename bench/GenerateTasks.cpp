@@ -0,0 +1,25 @@
+// Writes a synthetic CSV or JSON Lines task export for TaskImporter.
+//
+// Usage: generateTasks <path> [tasks] [csv|jsonl] [owners]
+#include <iostream>
+#include <string>
+#include "SyntheticTasks.h"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: generateTasks <path> [tasks] [csv|jsonl] [owners]\n";
+        return 1;
+    }
+    std::string path = argv[1];
+    std::size_t count = bench::sizeArg(argc, argv, 2, 1000000);
+    ImportFormat format = argc > 3 && std::string(argv[3]) == "jsonl" ? ImportFormat::JsonLines : ImportFormat::Csv;
+    std::size_t owners = bench::sizeArg(argc, argv, 4, 100);
+
+    std::size_t bytes = bench::writeSyntheticTasks(path, format, count, owners);
+    if (bytes == 0) {
+        std::cerr << "Could not write " << path << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << count << " tasks (" << bytes << " bytes) to " << path << "\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+// Measures TaskImporter throughput on synthetic CSV and JSON Lines exports:
+// parsing alone (chunks parsed on the pool, results discarded) and a full
+// import into a UserManager.
+//
+// Usage: benchImport [tasks] [threads] [owners] [directory]
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TaskImporter.h"
+#include "UserManager.h"
+#include "WorkStealingPool.h"
+#include "BinaryIO.h"
+#include "SyntheticTasks.h"
+
+namespace {
+
+void report(const char* format, const char* phase, double seconds, std::size_t bytes, std::size_t tasks) {
+    std::cout << std::left << std::setw(8) << format << std::setw(8) << phase << std::right
+              << std::setw(10) << std::fixed << std::setprecision(2) << bytes / seconds / 1e9 << " GB/s"
+              << std::setw(10) << std::setprecision(2) << tasks / seconds / 1e6 << " M tasks/s\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 5000000);
+    std::size_t threads = bench::sizeArg(argc, argv, 2, std::thread::hardware_concurrency());
+    std::size_t owners = bench::sizeArg(argc, argv, 3, 100);
+    std::string directory = argc > 4 ? argv[4] : "/tmp";
+
+    WorkStealingPool pool(threads);
+    std::cout << "tasks " << count << ", threads " << pool.threadCount() << "\n";
+    for (ImportFormat format : {ImportFormat::Csv, ImportFormat::JsonLines}) {
+        const char* label = format == ImportFormat::Csv ? "csv" : "jsonl";
+        std::string path = directory + "/bench_import." + label;
+        if (bench::writeSyntheticTasks(path, format, count, owners) == 0) {
+            std::cerr << "Could not write " << path << "\n";
+            return 1;
+        }
+        std::string contents;
+        binio::readFile(path, contents);
+
+        // Parse only: every chunk of the file on the pool at once
+        {
+            std::size_t chunkBytes = 1 << 20;
+            std::vector<std::string_view> pieces;
+            for (std::size_t start = 0; start < contents.size();) {
+                std::size_t end = std::min(start + chunkBytes, contents.size());
+                while (end < contents.size() && contents[end - 1] != '\n') {
+                    ++end;
+                }
+                pieces.push_back(std::string_view(contents).substr(start, end - start));
+                start = end;
+            }
+            std::vector<ParsedChunk> parsed(pieces.size());
+            bench::Timer timer;
+            for (std::size_t i = 0; i < pieces.size(); ++i) {
+                pool.submit([&, i] { TaskImporter::parseChunk(pieces[i], format, i == 0, parsed[i]); });
+            }
+            pool.wait();
+            report(label, "parse", timer.seconds(), contents.size(), count);
+        }
+
+        // Full import from the file, including the merge into users
+        {
+            ImportOptions options;
+            options.format = format;
+            options.createUsers = true;
+            options.defaultPassword = "bench";
+            UserManager users;
+            ImportResult result;
+            bench::Timer timer;
+            TaskImporter(pool, options).importFile(path, users, result);
+            report(label, "import", timer.seconds(), result.bytes, result.imported);
+            if (result.imported != count) {
+                std::cerr << "Imported " << result.imported << " of " << count << " tasks\n";
+            }
+        }
+        std::remove(path.c_str());
+    }
+    return 0;
+}
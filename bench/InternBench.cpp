@@ -0,0 +1,160 @@
+// Compares task objects that own a std::string name with interned names
+// (BaseTask today), on a dataset where many tasks share a few names.
+// Reports heap bytes per task, name-equality throughput and UserManager
+// lookup throughput.
+//
+// Usage: benchIntern [tasks] [distinctNames] [lookups]
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AiTask.h"
+#include "UserManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+std::atomic<std::size_t> heapBytes{0};
+
+// Stand-in for the old BaseTask layout: each task owns a copy of its name
+struct StringNamedTask {
+    std::string name;
+    int priority;
+    std::chrono::system_clock::time_point deadline;
+    int estimatedTime;
+    bool isCompleted;
+};
+
+void reportMemory(const char* representation, std::size_t bytes, std::size_t count) {
+    std::cout << std::left << std::setw(12) << representation << std::setw(10) << "memory" << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << static_cast<double>(bytes) / count
+              << " bytes/task\n";
+}
+
+void reportRate(const char* representation, const char* phase, double seconds, std::size_t count) {
+    std::cout << std::left << std::setw(12) << representation << std::setw(10) << phase << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << count / seconds / 1e6 << " M ops/s\n";
+}
+
+}
+
+// Count every heap allocation so memory per task includes string buffers
+void* operator new(std::size_t size) {
+    heapBytes += size;
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 2000000);
+    std::size_t distinct = bench::sizeArg(argc, argv, 2, 1000);
+    std::size_t lookups = bench::sizeArg(argc, argv, 3, 10000000);
+
+    // Longer than the small-string buffer, as real task names usually are
+    std::vector<std::string> names;
+    names.reserve(distinct);
+    for (std::size_t i = 0; i < distinct; ++i) {
+        names.push_back("recurring task name number " + std::to_string(i));
+    }
+    bench::Rng rng;
+    std::vector<std::size_t> picks(count);
+    for (auto& pick : picks) {
+        pick = rng.below(distinct);
+    }
+    std::vector<std::size_t> pairs(lookups * 2);
+    for (auto& index : pairs) {
+        index = rng.below(count);
+    }
+
+    {
+        std::size_t before = heapBytes;
+        std::vector<StringNamedTask> tasks;
+        tasks.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.push_back(StringNamedTask{names[picks[i]], 1, {}, 1, false});
+        }
+        reportMemory("string", heapBytes - before, count);
+
+        bench::Timer timer;
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            equal += tasks[pairs[2 * i]].name == tasks[pairs[2 * i + 1]].name;
+        }
+        bench::doNotOptimize(equal);
+        reportRate("string", "equality", timer.seconds(), lookups);
+    }
+
+    {
+        std::size_t before = heapBytes;
+        std::vector<AiTask> tasks;
+        tasks.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.emplace_back(names[picks[i]], 1, 1);
+        }
+        reportMemory("interned", heapBytes - before, count);
+
+        bench::Timer timer;
+        std::size_t equal = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            equal += tasks[pairs[2 * i]].hasSameName(tasks[pairs[2 * i + 1]]);
+        }
+        bench::doNotOptimize(equal);
+        reportRate("interned", "equality", timer.seconds(), lookups);
+    }
+
+    // Username lookups: the old string-keyed map against UserManager
+    {
+        std::unordered_map<std::string, std::shared_ptr<User>> byName;
+        UserManager manager;
+        for (std::size_t i = 0; i < distinct; ++i) {
+            manager.registerUser(names[i], "password");
+            byName.emplace(names[i], manager.findUser(names[i]));
+        }
+
+        bench::Timer timer;
+        std::size_t found = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            auto it = byName.find(names[picks[i % count]]);
+            std::shared_ptr<User> user = it != byName.end() ? it->second : nullptr;
+            found += user != nullptr;
+        }
+        bench::doNotOptimize(found);
+        reportRate("string", "findUser", timer.seconds(), lookups);
+
+        timer.reset();
+        found = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            found += manager.findUser(names[picks[i % count]]) != nullptr;
+        }
+        bench::doNotOptimize(found);
+        reportRate("interned", "findUser", timer.seconds(), lookups);
+
+        std::vector<Symbol> symbols(distinct);
+        for (std::size_t i = 0; i < distinct; ++i) {
+            symbols[i] = SymbolTable::global().find(names[i]);
+        }
+        timer.reset();
+        found = 0;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            found += manager.findUser(symbols[picks[i % count]]) != nullptr;
+        }
+        bench::doNotOptimize(found);
+        reportRate("symbol", "findUser", timer.seconds(), lookups);
+    }
+    return 0;
+}
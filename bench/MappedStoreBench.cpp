@@ -0,0 +1,65 @@
+// Compares startup and a first overdue scan for a memory-mapped task file
+// against loading the same tasks from a snapshot.
+//
+// Usage: benchMappedStore [tasks] [directory]
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "TaskManager.h"
+#include "UserManager.h"
+#include "BenchUtil.h"
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 5000000);
+    std::string directory = argc > 2 ? std::string(argv[2]) + "/" : std::string();
+    std::string mappedPath = directory + "bench_tasks.mapped";
+    std::string snapshotPath = directory + "bench_tasks.snap";
+
+    {
+        TaskManager manager;
+        UserManager users;
+        users.registerUser("bench", "password");
+        auto user = users.findUser("bench");
+        bench::Rng rng;
+        auto now = std::chrono::system_clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            Task task(static_cast<TaskKind>(i % TaskKindCount), "task-" + std::to_string(i),
+                      static_cast<int>(rng.below(3)) + 1, static_cast<int>(rng.below(40)),
+                      now + std::chrono::hours(static_cast<long>(rng.below(24 * 365))) - std::chrono::hours(24 * 30));
+            manager.addTask(task);
+            user->addTask(task);
+        }
+        if (!manager.saveReadOnly(mappedPath) || !users.saveSnapshot(snapshotPath)) {
+            std::cerr << "could not write benchmark files\n";
+            return 1;
+        }
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    bench::Timer timer;
+    TaskManager mapped;
+    if (!mapped.openReadOnly(mappedPath)) {
+        std::cerr << "could not open " << mappedPath << "\n";
+        return 1;
+    }
+    double openSeconds = timer.seconds();
+    timer.reset();
+    std::size_t overdue = mapped.overdueTasks().size();
+    double scanSeconds = timer.seconds();
+    std::cout << "mapped:   open " << openSeconds * 1e3 << " ms, overdue scan " << scanSeconds * 1e3
+              << " ms (" << overdue << " overdue)\n";
+
+    timer.reset();
+    UserManager loaded;
+    if (!loaded.loadSnapshot(snapshotPath)) {
+        std::cerr << "could not load " << snapshotPath << "\n";
+        return 1;
+    }
+    std::cout << "snapshot: load " << timer.seconds() * 1e3 << " ms\n";
+
+    std::remove(mappedPath.c_str());
+    std::remove(snapshotPath.c_str());
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Measures logged mutations per second for several group commit sizes.
+// Each run registers users and adds tasks through a UserManager whose
+// mutation log syncs once per 'batch' records.
+//
+// Usage: benchMutationLog [mutations] [directory]
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "UserManager.h"
+#include "BenchUtil.h"
+
+int main(int argc, char** argv) {
+    std::size_t mutations = bench::sizeArg(argc, argv, 1, 200000);
+    std::string directory = argc > 2 ? std::string(argv[2]) + "/" : std::string();
+    std::string snapshot = directory + "bench_wal.snap";
+    std::string logPath = directory + "bench_wal.log";
+
+    std::cout << std::setw(10) << "batch" << std::setw(16) << "mutations/s" << std::setw(10) << "fsyncs" << "\n";
+    for (std::size_t batch : {1, 8, 64, 512, 4096}) {
+        std::remove(snapshot.c_str());
+        std::remove(logPath.c_str());
+
+        // Syncing every record is slow on real disks, so that run does fewer mutations
+        std::size_t count = batch == 1 ? mutations / 20 : mutations;
+        MutationLog::Options options;
+        options.groupCommitSize = batch;
+        options.compactionBytes = ~0ull;
+
+        UserManager manager;
+        if (!manager.openStorage(snapshot, logPath, options)) {
+            std::cerr << "could not open " << logPath << "\n";
+            return 1;
+        }
+        bench::Timer timer;
+        manager.registerUser("bench", "password");
+        auto user = manager.findUser("bench");
+        for (std::size_t i = 1; i < count; ++i) {
+            if (i % 4 == 3) {
+                user->markTaskComplete("task-" + std::to_string(i - 1));
+            } else {
+                user->addTask(Task(TaskKind::Hpc, "task-" + std::to_string(i), 2, 3));
+            }
+        }
+        manager.syncLog();
+        double elapsed = timer.seconds();
+
+        std::cout << std::setw(10) << batch << std::setw(16) << std::fixed << std::setprecision(0) << count / elapsed
+                  << std::setw(10) << manager.logSequence() / batch << "\n";
+    }
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+    return 0;
+}
@@ -0,0 +1,42 @@
+// Measures TaskManager::markTaskComplete latency as the task count grows.
+// With the name index the cost per lookup should stay flat from 1k to 10M tasks.
+//
+// Usage: benchNameIndex [maxTasks] [lookups]
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "AiTask.h"
+#include "BenchUtil.h"
+
+int main(int argc, char** argv) {
+    std::size_t maxTasks = bench::sizeArg(argc, argv, 1, 10000000);
+    std::size_t lookups = bench::sizeArg(argc, argv, 2, 1000000);
+
+    std::cout << std::setw(12) << "tasks" << std::setw(16) << "ns/lookup" << "\n";
+    for (std::size_t count = 1000; count <= maxTasks; count *= 10) {
+        TaskManager manager;
+        std::vector<std::string> names;
+        names.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            names.push_back("task-" + std::to_string(i));
+            manager.addTask(std::make_unique<AiTask>(names.back(), static_cast<int>(i % 3) + 1, 1));
+        }
+        manager.prioritizeTasks();
+
+        bench::Rng rng;
+        std::size_t found = 0;
+        bench::Timer timer;
+        for (std::size_t i = 0; i < lookups; ++i) {
+            found += manager.markTaskComplete(names[rng.below(count)]);
+        }
+        double elapsed = timer.seconds();
+        bench::doNotOptimize(found);
+
+        std::cout << std::setw(12) << count
+                  << std::setw(16) << std::fixed << std::setprecision(1) << elapsed * 1e9 / lookups << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+// Interleaves inserts with sorted reads and compares the incrementally kept
+// PriorityIndex against re-sorting every task on each read, which is what
+// prioritizeTasks and displaySortedTasks used to do. Also times top-k reads.
+//
+// Usage: benchPriorityOrder [tasks] [insertsPerRead] [k]
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void report(const char* label, double seconds, std::size_t reads) {
+    std::cout << std::left << std::setw(28) << label << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1e3 << " ms";
+    if (reads > 0) {
+        std::cout << std::setw(14) << std::setprecision(1) << reads / seconds << " reads/s";
+    }
+    std::cout << '\n';
+}
+
+// Fill a manager with 'count' tasks, calling read() after every 'batch' inserts
+template <typename Read>
+double run(std::size_t count, std::size_t batch, Read read) {
+    TaskManager manager;
+    bench::Rng rng;
+    auto now = TaskStore::TimePoint(std::chrono::hours(480000));
+    bench::Timer timer;
+    for (std::size_t i = 0; i < count; ++i) {
+        manager.addTask(Task(TaskKind::Ai, "task-" + std::to_string(i), static_cast<int>(rng.below(3)) + 1, 1,
+                             now + std::chrono::minutes(rng.below(100000))));
+        if ((i + 1) % batch == 0) {
+            read(manager);
+        }
+    }
+    return timer.seconds();
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 100000);
+    std::size_t batch = std::max<std::size_t>(1, bench::sizeArg(argc, argv, 2, 1000));
+    std::size_t k = bench::sizeArg(argc, argv, 3, 10);
+    std::size_t reads = count / batch;
+    std::cout << count << " inserts, a read every " << batch << " inserts (" << reads << " reads)\n";
+
+    double baseline = run(count, 1, [](TaskManager&) {});
+    report("inserts only", baseline, 0);
+
+    std::size_t checksum = 0;
+    double resorted = run(count, batch, [&](TaskManager& manager) {
+        const TaskStore& store = manager.getStore();
+        std::vector<TaskId> ids;
+        ids.reserve(store.size());
+        store.forEach([&](TaskId id) { ids.push_back(id); });
+        std::stable_sort(ids.begin(), ids.end(), [&](TaskId a, TaskId b) {
+            if (store.priority(a) != store.priority(b)) {
+                return store.priority(a) > store.priority(b);
+            }
+            return store.deadline(a) < store.deadline(b);
+        });
+        checksum += ids.front();
+    });
+    report("re-sort per read", resorted, reads);
+
+    double indexed = run(count, batch, [&](TaskManager& manager) {
+        manager.getPriorityIndex().forEachSorted([&](TaskId id) { checksum += id; });
+    });
+    report("indexed sorted view", indexed, reads);
+
+    double topK = run(count, batch, [&](TaskManager& manager) {
+        for (TaskId id : manager.getPriorityIndex().top(k)) {
+            checksum += id;
+        }
+    });
+    report("indexed top-k", topK, reads);
+
+    bench::doNotOptimize(checksum);
+    return 0;
+}
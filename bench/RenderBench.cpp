@@ -0,0 +1,60 @@
+// Measures displayTasksByPriority throughput in lines per second when the
+// report goes to a regular file and to /dev/null. The "per-line" rows repeat
+// the report the old way (three scans, one std::endl per task) for comparison.
+//
+// Usage: benchRender [tasks] [outputFile]
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "TaskManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void perLineReport(const TaskManager& manager, std::ostream& out) {
+    const TaskStore& store = manager.getStore();
+    for (int level = 3; level >= 1; --level) {
+        out << "\nPriority " << level << " Tasks:\n";
+        store.forEach([&](TaskId id) {
+            if (store.priority(id) == level) {
+                store.get(id).print(out);
+                out << std::endl;
+            }
+        });
+    }
+}
+
+template <typename Report>
+void measure(const char* label, const char* path, std::size_t lines, Report report) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    bench::Timer timer;
+    report(out);
+    double elapsed = timer.seconds();
+    std::cout << std::left << std::setw(24) << label << std::right
+              << std::setw(14) << std::fixed << std::setprecision(2) << lines / elapsed / 1e6 << " M lines/s\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 1000000);
+    std::string file = argc > 2 ? argv[2] : "bench_render_output.txt";
+
+    TaskManager manager;
+    bench::Rng rng;
+    auto base = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        Task task(static_cast<TaskKind>(i % TaskKindCount), "task-" + std::to_string(i),
+                  static_cast<int>(rng.below(3)) + 1, static_cast<int>(rng.below(40)),
+                  base + std::chrono::hours(rng.below(24 * 90)));
+        manager.addTask(task);
+    }
+    std::size_t lines = count + 3;
+
+    measure("buffered -> file", file.c_str(), lines, [&](std::ostream& out) { manager.displayTasksByPriority(out); });
+    measure("buffered -> /dev/null", "/dev/null", lines, [&](std::ostream& out) { manager.displayTasksByPriority(out); });
+    measure("per-line -> file", file.c_str(), lines, [&](std::ostream& out) { perLineReport(manager, out); });
+    measure("per-line -> /dev/null", "/dev/null", lines, [&](std::ostream& out) { perLineReport(manager, out); });
+    return 0;
+}
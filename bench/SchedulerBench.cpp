@@ -0,0 +1,82 @@
+// Plans 1M open tasks under each policy, then measures incremental re-plans
+// after small batches of adds and completions. A re-plan only merges and
+// re-times the plan from the first changed position, so changes that land
+// late in the plan are much cheaper than a full rebuild.
+//
+// Usage: benchScheduler [tasks] [changesPerReplan] [replans]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "Scheduler.h"
+#include "TaskManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+const char* policyName(SchedulePolicy policy) {
+    switch (policy) {
+    case SchedulePolicy::EarliestDeadline: return "EDF";
+    case SchedulePolicy::WeightedShortestJob: return "WSJF";
+    case SchedulePolicy::Hybrid: return "hybrid";
+    }
+    return "?";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 1000000);
+    std::size_t changes = bench::sizeArg(argc, argv, 2, 100);
+    std::size_t replans = bench::sizeArg(argc, argv, 3, 20);
+
+    auto start = TaskStore::TimePoint(std::chrono::hours(1000));
+    TaskStore store;
+    store.reserve(count + changes * replans);
+    bench::Rng rng;
+    for (std::size_t i = 0; i < count; ++i) {
+        store.add(TaskKind::Hpc, "task-" + std::to_string(i), static_cast<int>(rng.below(3)) + 1,
+                  static_cast<int>(rng.below(3)) + 1, start + std::chrono::hours(rng.below(count * 2)), false);
+    }
+    std::cout << count << " tasks, " << changes << " changes per re-plan\n";
+
+    SchedulePolicy policies[] = {SchedulePolicy::EarliestDeadline, SchedulePolicy::WeightedShortestJob,
+                                 SchedulePolicy::Hybrid};
+    for (SchedulePolicy policy : policies) {
+        ScheduleOptions options;
+        options.policy = policy;
+        options.start = start;
+        Scheduler scheduler(options);
+
+        bench::Timer timer;
+        scheduler.rebuild(store);
+        ScheduleSummary summary = scheduler.summary();
+        double full = timer.seconds();
+
+        // Each round completes some planned tasks and adds new ones
+        double incremental = 0;
+        std::size_t retimed = 0;
+        for (std::size_t round = 0; round < replans; ++round) {
+            timer.reset();
+            for (std::size_t c = 0; c < changes; ++c) {
+                if (c % 2 == 0) {
+                    scheduler.remove(static_cast<TaskId>(rng.below(count)));
+                } else {
+                    TaskId id = static_cast<TaskId>(store.capacity() + round * changes + c);
+                    scheduler.add(id, static_cast<int>(rng.below(3)) + 1, static_cast<int>(rng.below(3)) + 1,
+                                  start + std::chrono::hours(rng.below(count * 2)));
+                }
+            }
+            summary = scheduler.summary();
+            incremental += timer.seconds();
+            retimed += scheduler.lastReplanSize();
+        }
+
+        std::cout << std::left << std::setw(8) << policyName(policy) << std::right << std::fixed
+                  << " full " << std::setw(9) << std::setprecision(1) << full * 1e3 << " ms"
+                  << "   re-plan " << std::setw(8) << std::setprecision(2) << incremental / replans * 1e3 << " ms"
+                  << "   re-timed " << std::setw(8) << retimed / replans
+                  << "   late " << std::setw(8) << summary.lateTasks
+                  << "   lateness " << std::setprecision(0) << summary.totalLatenessHours << " h\n";
+    }
+    return 0;
+}
@@ -0,0 +1,182 @@
+// Load generator for TaskServer. Each connection runs on its own thread,
+// registers and logs in its own user, then sends a mix of requests (90%
+// AddTask, 9% MarkTaskComplete, 1% ListTasks) in pipelined batches of
+// 'depth' and waits for the batch's responses before sending the next.
+// Reports throughput and the p50/p99/max latency of a request, measured
+// from the write of its batch to the arrival of its response.
+//
+// Usage: taskLoadClient [connections] [requests per connection] [depth] [address]
+//
+// 'address' is a Unix socket path or host:port. Without one, an in-process
+// server is started on a temporary socket with its log in /tmp, so the
+// numbers include the per-round log sync.
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "TaskClient.h"
+#include "TaskServer.h"
+#include "UserManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Address {
+    std::string unixPath;
+    std::string host;
+    int port = 0;
+};
+
+bool connect(TaskClient& client, const Address& address) {
+    return address.unixPath.empty() ? client.connectTcp(address.host, address.port)
+                                    : client.connectUnix(address.unixPath);
+}
+
+struct WorkerResult {
+    std::vector<double> latencies;  // Microseconds
+    std::size_t failures = 0;
+    bool connected = false;
+};
+
+void runConnection(const Address& address, std::size_t index, std::size_t requests, std::size_t depth,
+                   WorkerResult& result) {
+    TaskClient client;
+    if (!connect(client, address)) {
+        return;
+    }
+    std::string username = "load-" + std::to_string(index) + "-" + std::to_string(::getpid());
+    client.registerUser(username, "secret");
+    if (client.login(username, "secret") != protocol::Status::Ok) {
+        return;
+    }
+    result.connected = true;
+    result.latencies.reserve(requests);
+
+    bench::Rng rng(index + 1);
+    auto deadline = std::chrono::system_clock::now() + std::chrono::hours(24);
+    std::size_t added = 0;
+    std::size_t completed = 0;
+    TaskClient::Response response;
+    for (std::size_t sent = 0; sent < requests;) {
+        std::size_t batch = std::min(depth, requests - sent);
+        for (std::size_t i = 0; i < batch; ++i) {
+            std::size_t pick = rng.below(100);
+            if (pick < 9 && completed < added) {
+                client.sendMarkTaskComplete("Load task " + std::to_string(completed++));
+            } else if (pick == 99) {
+                client.sendListTasks();
+            } else {
+                client.sendAddTask(Task(static_cast<TaskKind>(rng.below(TaskKindCount)),
+                                        "Load task " + std::to_string(added++),
+                                        static_cast<int>(rng.below(3)) + 1, static_cast<int>(rng.below(40)) + 1,
+                                        deadline));
+            }
+        }
+        Clock::time_point start = Clock::now();
+        if (!client.flush()) {
+            result.failures += requests - sent;
+            return;
+        }
+        for (std::size_t i = 0; i < batch; ++i) {
+            if (!client.receive(response)) {
+                result.failures += requests - sent - i;
+                return;
+            }
+            if (response.status != protocol::Status::Ok) {
+                ++result.failures;
+            }
+            result.latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        sent += batch;
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t connections = bench::sizeArg(argc, argv, 1, 8);
+    std::size_t requests = bench::sizeArg(argc, argv, 2, 20000);
+    std::size_t depth = std::max<std::size_t>(1, bench::sizeArg(argc, argv, 3, 32));
+
+    Address address;
+    UserManager userManager;
+    std::unique_ptr<TaskServer> server;
+    std::thread serverThread;
+    std::string storagePrefix = "/tmp/task_load_" + std::to_string(::getpid());
+    if (argc > 4) {
+        std::string target = argv[4];
+        std::size_t colon = target.rfind(':');
+        if (colon != std::string::npos && target.find('/') == std::string::npos) {
+            address.host = target.substr(0, colon);
+            address.port = std::atoi(target.c_str() + colon + 1);
+        } else {
+            address.unixPath = target;
+        }
+    } else {
+        MutationLog::Options storageOptions;
+        storageOptions.groupCommitSize = std::numeric_limits<std::size_t>::max();
+        userManager.openStorage(storagePrefix + ".snap", storagePrefix + ".wal", storageOptions);
+        address.unixPath = storagePrefix + ".sock";
+        server = std::make_unique<TaskServer>(userManager);
+        if (!server->listenUnix(address.unixPath)) {
+            std::cerr << "Could not listen on " << address.unixPath << "\n";
+            return 1;
+        }
+        serverThread = std::thread([&] { server->run(); });
+    }
+
+    std::vector<WorkerResult> results(connections);
+    std::vector<std::thread> workers;
+    bench::Timer timer;
+    for (std::size_t i = 0; i < connections; ++i) {
+        workers.emplace_back(runConnection, std::cref(address), i, requests, depth, std::ref(results[i]));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = timer.seconds();
+
+    if (server) {
+        server->stop();
+        serverThread.join();
+        server.reset();
+        std::remove((storagePrefix + ".snap").c_str());
+        std::remove((storagePrefix + ".wal").c_str());
+    }
+
+    std::vector<double> latencies;
+    std::size_t failures = 0;
+    std::size_t connected = 0;
+    for (WorkerResult& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        failures += result.failures;
+        connected += result.connected ? 1 : 0;
+    }
+    if (connected < connections) {
+        std::cerr << connections - connected << " connections failed to connect or log in\n";
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "connections " << connections << ", requests " << latencies.size() << ", depth " << depth
+              << ", failures " << failures << "\n";
+    std::cout << std::fixed << std::setprecision(2) << "throughput " << latencies.size() / seconds / 1e3
+              << " K requests/s\n";
+    std::cout << std::setprecision(1) << "latency us: p50 " << percentile(latencies, 0.50) << ", p99 "
+              << percentile(latencies, 0.99) << ", max " << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+    return failures == 0 && connected == connections ? 0 : 1;
+}
@@ -0,0 +1,57 @@
+// Measures UserManager snapshot save and load throughput.
+//
+// Usage: benchSnapshot [tasks] [users] [path]
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "UserManager.h"
+#include "BenchUtil.h"
+
+int main(int argc, char** argv) {
+    std::size_t taskCount = bench::sizeArg(argc, argv, 1, 5000000);
+    std::size_t userCount = bench::sizeArg(argc, argv, 2, 1000);
+    std::string path = argc > 3 ? argv[3] : "bench_snapshot.snap";
+
+    UserManager manager;
+    for (std::size_t u = 0; u < userCount; ++u) {
+        manager.registerUser("user-" + std::to_string(u), "password-" + std::to_string(u));
+    }
+    bench::Rng rng;
+    auto base = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < taskCount; ++i) {
+        auto user = manager.findUser("user-" + std::to_string(i % userCount));
+        user->addTask(Task(static_cast<TaskKind>(rng.below(TaskKindCount)), "task-" + std::to_string(i / userCount),
+                           static_cast<int>(rng.below(3)) + 1, static_cast<int>(rng.below(40)),
+                           base + std::chrono::hours(rng.below(24 * 365))));
+    }
+
+    bench::Timer timer;
+    if (!manager.saveSnapshot(path)) {
+        std::cerr << "save failed\n";
+        return 1;
+    }
+    double saveSeconds = timer.seconds();
+
+    UserManager loaded;
+    timer.reset();
+    if (!loaded.loadSnapshot(path)) {
+        std::cerr << "load failed\n";
+        return 1;
+    }
+    double loadSeconds = timer.seconds();
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    double megabytes = std::ftell(file) / 1e6;
+    std::fclose(file);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "tasks " << taskCount << ", users " << userCount << ", file " << megabytes << " MB\n"
+              << "save " << saveSeconds << " s (" << taskCount / saveSeconds / 1e6 << " M tasks/s, "
+              << megabytes / saveSeconds << " MB/s)\n"
+              << "load " << loadSeconds << " s (" << taskCount / loadSeconds / 1e6 << " M tasks/s, "
+              << megabytes / loadSeconds << " MB/s)\n";
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,94 @@
+// Read throughput of VersionedTaskManager snapshots with and without a
+// concurrent writer doing about 10k mutations per second. Readers take a
+// snapshot and scan every task in it; with RCU-style versions the read rate
+// should stay flat when the writer is switched on.
+//
+// Usage: benchSnapshotReaders [tasks] [readers] [seconds] [writesPerSecond]
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "VersionedTaskManager.h"
+#include "BenchUtil.h"
+
+namespace {
+
+struct Result {
+    double scansPerSecond;
+    double writesPerSecond;
+};
+
+Result measure(VersionedTaskManager& manager, std::size_t readers, double seconds, std::size_t writesPerSecond,
+               std::size_t& nextName) {
+    std::atomic<bool> stop(false);
+    std::atomic<std::size_t> scans(0);
+    std::vector<std::thread> threads;
+    for (std::size_t r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                std::shared_ptr<const TaskSnapshot> view = manager.snapshot();
+                long long hours = 0;
+                view->forEach([&](TaskId id) {
+                    if (view->priority(id) == 3 && !view->isCompleted(id)) {
+                        hours += view->estimatedTime(id);
+                    }
+                });
+                bench::doNotOptimize(hours);
+                scans.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::size_t writes = 0;
+    bench::Timer timer;
+    if (writesPerSecond > 0) {
+        // Writes are paced in 1 ms slices to hold the requested rate
+        std::size_t perSlice = std::max<std::size_t>(1, writesPerSecond / 1000);
+        auto next = std::chrono::steady_clock::now();
+        while (timer.seconds() < seconds) {
+            for (std::size_t i = 0; i < perSlice; ++i, ++writes) {
+                std::string name = "task-" + std::to_string(nextName++);
+                manager.addTask(Task(TaskKind::Ai, name, 3, 1));
+                if (writes % 2 == 0) {
+                    manager.markTaskComplete(name);
+                }
+            }
+            next += std::chrono::milliseconds(1);
+            std::this_thread::sleep_until(next);
+        }
+    } else {
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    }
+    double elapsed = timer.seconds();
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return Result{scans / elapsed, writes / elapsed};
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t taskCount = bench::sizeArg(argc, argv, 1, 200000);
+    std::size_t readers = bench::sizeArg(argc, argv, 2, 2);
+    double seconds = static_cast<double>(bench::sizeArg(argc, argv, 3, 3));
+    std::size_t writesPerSecond = bench::sizeArg(argc, argv, 4, 10000);
+
+    VersionedTaskManager manager;
+    std::size_t nextName = 0;
+    for (; nextName < taskCount; ++nextName) {
+        manager.addTask(Task(TaskKind::Hpc, "task-" + std::to_string(nextName), static_cast<int>(nextName % 3) + 1, 2));
+    }
+
+    Result idle = measure(manager, readers, seconds, 0, nextName);
+    Result busy = measure(manager, readers, seconds, writesPerSecond, nextName);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "readers " << readers << ", tasks " << taskCount << "\n"
+              << "no writer:      " << idle.scansPerSecond << " scans/s\n"
+              << "with writer:    " << busy.scansPerSecond << " scans/s at " << busy.writesPerSecond << " writes/s\n";
+    return 0;
+}
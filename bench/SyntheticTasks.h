@@ -0,0 +1,63 @@
+#ifndef SYNTHETIC_TASKS_H
+#define SYNTHETIC_TASKS_H
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include "TaskImporter.h"
+#include "BenchUtil.h"
+
+// Synthetic task exports for the importer benchmarks
+namespace bench {
+
+// Write 'count' tasks spread over 'owners' users in the given format.
+// Returns the number of bytes written, or 0 if the file cannot be written.
+inline std::size_t writeSyntheticTasks(const std::string& path, ImportFormat format, std::size_t count,
+                                       std::size_t owners, unsigned long long seed = 88172645463325252ULL) {
+    static const char* const kinds[] = {"ai", "hpc", "programming", "devops"};
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return 0;
+    }
+    Rng rng(seed);
+    std::time_t base = 1735689600; // 2025-01-01T00:00:00Z
+    std::string out;
+    std::size_t written = 0;
+    char line[256];
+    if (format == ImportFormat::Csv) {
+        out = "name,kind,priority,estimatedTime,deadline,owner\n";
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        std::time_t deadline = base + static_cast<std::time_t>(rng.below(365 * 24)) * 3600;
+        std::tm utc;
+        gmtime_r(&deadline, &utc);
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+        const char* kind = kinds[rng.below(4)];
+        int priority = static_cast<int>(rng.below(3)) + 1;
+        int hours = static_cast<int>(rng.below(40)) + 1;
+        std::size_t owner = rng.below(owners);
+        int length;
+        if (format == ImportFormat::Csv) {
+            length = std::snprintf(line, sizeof(line), "Imported task %zu,%s,%d,%d,%s,user-%zu\n",
+                                   i, kind, priority, hours, stamp, owner);
+        } else {
+            length = std::snprintf(line, sizeof(line),
+                                   "{\"name\":\"Imported task %zu\",\"kind\":\"%s\",\"priority\":%d,"
+                                   "\"estimatedTime\":%d,\"deadline\":\"%s\",\"owner\":\"user-%zu\"}\n",
+                                   i, kind, priority, hours, stamp, owner);
+        }
+        out.append(line, static_cast<std::size_t>(length));
+        if (out.size() >= (1 << 20)) {
+            written += std::fwrite(out.data(), 1, out.size(), file);
+            out.clear();
+        }
+    }
+    written += std::fwrite(out.data(), 1, out.size(), file);
+    bool ok = std::fclose(file) == 0;
+    return ok ? written : 0;
+}
+
+}
+
+#endif
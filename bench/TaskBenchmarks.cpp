@@ -0,0 +1,368 @@
+// Google Benchmark suite over the main TaskManager, User and UserManager
+// operations, at dataset sizes from 1e3 up to 1e7 tasks.
+//
+//   taskBenchmarks --benchmark_filter=AddTask
+//   taskBenchmarks --benchmark_out=before.json --benchmark_out_format=json
+//
+// Two JSON files from different commits can be compared with
+// tools/compare.py from the Google Benchmark sources. The benchmarkJson
+// target writes benchmarks.json in the build directory.
+//
+// Listings render roughly 100 bytes per task, so they stop at 1e6 tasks.
+// Each User carries its own arena, so user counts stop at 1e6 as well.
+//
+// The session benchmarks run on 1 to 8 threads against one UserManager and
+// report wall-clock throughput across all threads.
+//
+// Benchmarks with a "stats" argument run once with OpStats recording off
+// (stats:0) and once with it on (stats:1). The difference is often lost in
+// run-to-run noise, so BM_OpTimer measures the per-call cost on its own.
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "UserManager.h"
+#include "OpStats.h"
+#include "TaskGenerators.h"
+
+namespace {
+
+constexpr std::int64_t MinSize = 1000;
+constexpr std::int64_t MaxTasks = 10000000;
+constexpr std::int64_t MaxListing = 1000000;
+constexpr std::int64_t MaxUsers = 1000000;
+constexpr int MaxSessionThreads = 8;
+constexpr std::size_t SessionUsers = 100000;
+constexpr std::size_t TasksPerSessionUser = 10000;
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+NullBuffer nullBuffer;
+std::ostream nullStream(&nullBuffer);
+
+// Points std::cout at the null sink for its lifetime
+class SilenceCout {
+private:
+    std::streambuf* previous;
+
+public:
+    SilenceCout() : previous(std::cout.rdbuf(&nullBuffer)) {}
+    ~SilenceCout() { std::cout.rdbuf(previous); }
+};
+
+// Datasets take seconds to build at the larger sizes, while Google Benchmark
+// calls each benchmark several times while it settles on an iteration count.
+// The most recent dataset is kept between those calls. Only one is kept at a
+// time, so the 1e7 datasets never coexist.
+template <typename T>
+T& dataset(const char* family, std::size_t size, const std::function<std::unique_ptr<T>()>& build) {
+    static std::string cachedFamily;
+    static std::size_t cachedSize = 0;
+    static std::shared_ptr<void> cached;
+    if (!cached || cachedFamily != family || cachedSize != size) {
+        cached.reset();  // Free the old dataset before building the new one
+        cached = std::shared_ptr<T>(build());
+        cachedFamily = family;
+        cachedSize = size;
+    }
+    return *static_cast<T*>(cached.get());
+}
+
+// Turn OpStats recording on for the benchmark if its "stats" argument is 1
+class StatsSwitch {
+public:
+    explicit StatsSwitch(std::int64_t stats) {
+        OpStats::setEnabled(stats != 0);
+    }
+    ~StatsSwitch() { OpStats::setEnabled(false); }
+};
+
+const std::vector<Task>& tasksOf(std::size_t size) {
+    return dataset<std::vector<Task>>("tasks", size, [size] {
+        return std::make_unique<std::vector<Task>>(bench::generateTasks(size));
+    });
+}
+
+std::unique_ptr<TaskManager> managerWith(const std::vector<Task>& tasks) {
+    auto manager = std::make_unique<TaskManager>();
+    for (const Task& task : tasks) {
+        manager->addTask(task);
+    }
+    return manager;
+}
+
+void BM_TaskManagerAddTask(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    StatsSwitch stats(state.range(1));
+    const std::vector<Task>& tasks = tasksOf(size);
+    for (auto _ : state) {
+        auto manager = std::make_unique<TaskManager>();
+        for (const Task& task : tasks) {
+            manager->addTask(task);
+        }
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+void BM_TaskManagerAddTasks(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    const std::vector<Task>& tasks = tasksOf(size);
+    for (auto _ : state) {
+        auto manager = std::make_unique<TaskManager>();
+        manager->addTasks(tasks);
+        state.PauseTiming();
+        manager.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+void BM_TaskManagerPrioritizeTasks(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    TaskManager& manager = dataset<TaskManager>("manager", size, [size] {
+        return managerWith(bench::generateTasks(size));
+    });
+    for (auto _ : state) {
+        manager.prioritizeTasks();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+struct CompletionRun {
+    std::vector<Task> tasks;
+    std::vector<std::string> names;  // Shuffled completion order
+    std::unique_ptr<TaskManager> manager;
+    std::size_t next = 0;
+};
+
+void BM_TaskManagerMarkTaskComplete(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    StatsSwitch stats(state.range(1));
+    CompletionRun& run = dataset<CompletionRun>("complete", size, [size] {
+        auto run = std::make_unique<CompletionRun>();
+        run->tasks = bench::generateTasks(size);
+        bench::Rng rng(size);
+        for (const Task& task : run->tasks) {
+            run->names.push_back(task.name);
+        }
+        for (std::size_t i = run->names.size(); i > 1; --i) {
+            std::swap(run->names[i - 1], run->names[rng.below(i)]);
+        }
+        run->manager = managerWith(run->tasks);
+        return run;
+    });
+    for (auto _ : state) {
+        if (run.next == run.names.size()) {
+            // Every task is complete; start over with a fresh manager
+            state.PauseTiming();
+            run.manager.reset();
+            run.manager = managerWith(run.tasks);
+            run.next = 0;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(run.manager->markTaskComplete(run.names[run.next++]));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+void BM_TaskManagerDisplayTasksByPriority(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    StatsSwitch stats(state.range(1));
+    TaskManager& manager = dataset<TaskManager>("manager", size, [size] {
+        return managerWith(bench::generateTasks(size));
+    });
+    for (auto _ : state) {
+        manager.displayTasksByPriority(nullStream);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+void BM_UserDisplaySortedTasks(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    User& user = dataset<User>("user", size, [size] {
+        auto user = std::make_unique<User>("benchmark.user", "secret");
+        user->addTasks(bench::generateTasks(size));
+        return user;
+    });
+    SilenceCout silence;
+    for (auto _ : state) {
+        user.displaySortedTasks();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+const std::vector<std::string>& usernamesOf(std::size_t size) {
+    return dataset<std::vector<std::string>>("usernames", size, [size] {
+        return std::make_unique<std::vector<std::string>>(bench::generateUsernames(size));
+    });
+}
+
+void BM_UserManagerRegisterUser(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    const std::vector<std::string>& names = usernamesOf(size);
+    const std::string password = "correct horse battery staple";
+    for (auto _ : state) {
+        auto users = std::make_unique<UserManager>();
+        for (const std::string& name : names) {
+            users->registerUser(name, password);
+        }
+        state.PauseTiming();
+        users.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+}
+
+struct LoginRun {
+    std::vector<std::string> names;
+    UserManager users;
+    std::size_t next = 0;
+};
+
+void BM_UserManagerLoginUser(benchmark::State& state) {
+    std::size_t size = static_cast<std::size_t>(state.range(0));
+    StatsSwitch stats(state.range(1));
+    LoginRun& run = dataset<LoginRun>("login", size, [size] {
+        auto run = std::make_unique<LoginRun>();
+        run->names = bench::generateUsernames(size);
+        for (const std::string& name : run->names) {
+            run->users.registerUser(name, "secret");
+        }
+        // Log in in a scattered order rather than registration order
+        bench::Rng rng(size);
+        for (std::size_t i = run->names.size(); i > 1; --i) {
+            std::swap(run->names[i - 1], run->names[rng.below(i)]);
+        }
+        return run;
+    });
+    const std::string password = "secret";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(run.users.loginUser(run.names[run.next], password));
+        run.next = run.next + 1 == run.names.size() ? 0 : run.next + 1;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Users shared by the multi-threaded session benchmarks, with one open
+// session per user. Thread 0 builds it before the timed loop; the other
+// threads only touch it inside the loop, which Google Benchmark starts on
+// every thread at once.
+struct SessionRun {
+    UserManager users;
+    std::vector<std::string> names;
+    std::vector<SessionToken> sessions;
+    std::vector<std::string> taskNames;  // Tasks every session user has
+};
+
+SessionRun* sessionRun = nullptr;
+
+void BM_UserManagerOpenSession(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        sessionRun = &dataset<SessionRun>("sessions", SessionUsers, [] {
+            auto run = std::make_unique<SessionRun>();
+            run->names = bench::generateUsernames(SessionUsers);
+            for (const std::string& name : run->names) {
+                run->users.registerUser(name, "secret");
+            }
+            return run;
+        });
+    }
+    const std::string password = "secret";
+    std::size_t next = static_cast<std::size_t>(state.thread_index()) * (SessionUsers / MaxSessionThreads);
+    for (auto _ : state) {
+        SessionRun& run = *sessionRun;
+        SessionToken session = run.users.openSession(run.names[next], password);
+        run.users.closeSession(session);
+        next = next + 1 == SessionUsers ? 0 : next + 1;
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Task updates through sessions: "shared:0" gives every thread a user of its
+// own, "shared:1" points all threads at the same user
+void BM_SessionUpdateTask(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        sessionRun = &dataset<SessionRun>("session tasks", MaxSessionThreads, [] {
+            auto run = std::make_unique<SessionRun>();
+            std::vector<Task> tasks = bench::generateTasks(TasksPerSessionUser);
+            for (const Task& task : tasks) {
+                run->taskNames.push_back(task.name);
+            }
+            run->names = bench::generateUsernames(MaxSessionThreads);
+            for (const std::string& name : run->names) {
+                run->users.registerUser(name, "secret");
+                run->users.findUser(name)->addTasks(tasks);
+                run->sessions.push_back(run->users.openSession(name, "secret"));
+            }
+            return run;
+        });
+    }
+    std::size_t user = state.range(0) != 0 ? 0 : static_cast<std::size_t>(state.thread_index());
+    std::size_t next = 0;
+    int priority = 1;
+    auto deadline = bench::generatorEpoch();
+    for (auto _ : state) {
+        SessionRun& run = *sessionRun;
+        const std::string& name = run.taskNames[next];
+        run.users.withSession(run.sessions[user], [&](User& owner) {
+            owner.updateTask(name, priority, deadline);
+        });
+        if (++next == TasksPerSessionUser) {
+            next = 0;
+            priority = priority % 3 + 1;
+            deadline += std::chrono::hours(1);
+        }
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+// Cost of an OpTimer around an empty scope
+void BM_OpTimer(benchmark::State& state) {
+    StatsSwitch stats(state.range(0));
+    for (auto _ : state) {
+        OpTimer timer(Operation::Login);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+}
+
+BENCHMARK(BM_TaskManagerAddTask)
+    ->ArgsProduct({benchmark::CreateRange(MinSize, MaxTasks, 10), {0, 1}})
+    ->ArgNames({"size", "stats"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TaskManagerAddTasks)->RangeMultiplier(10)->Range(MinSize, MaxTasks)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TaskManagerPrioritizeTasks)->RangeMultiplier(10)->Range(MinSize, MaxTasks)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TaskManagerMarkTaskComplete)
+    ->ArgsProduct({benchmark::CreateRange(MinSize, MaxTasks, 10), {0, 1}})
+    ->ArgNames({"size", "stats"});
+BENCHMARK(BM_TaskManagerDisplayTasksByPriority)
+    ->ArgsProduct({benchmark::CreateRange(MinSize, MaxListing, 10), {0, 1}})
+    ->ArgNames({"size", "stats"})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UserDisplaySortedTasks)->RangeMultiplier(10)->Range(MinSize, MaxListing)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UserManagerRegisterUser)->RangeMultiplier(10)->Range(MinSize, MaxUsers)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UserManagerLoginUser)
+    ->ArgsProduct({benchmark::CreateRange(MinSize, MaxUsers, 10), {0, 1}})
+    ->ArgNames({"size", "stats"});
+
+BENCHMARK(BM_UserManagerOpenSession)->ThreadRange(1, MaxSessionThreads)->UseRealTime();
+BENCHMARK(BM_SessionUpdateTask)->Arg(0)->Arg(1)->ArgName("shared")->ThreadRange(1, MaxSessionThreads)->UseRealTime();
+BENCHMARK(BM_OpTimer)->Arg(0)->Arg(1)->ArgName("stats");
+
+BENCHMARK_MAIN();
@@ -0,0 +1,76 @@
+#ifndef TASK_GENERATORS_H
+#define TASK_GENERATORS_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Task.h"
+#include "BenchUtil.h"
+
+// Synthetic but plausible task and user data for the benchmark suite. The
+// distributions are skewed the way real task lists are: most tasks are
+// medium priority and due within a month, estimates are mostly small, and
+// a tenth of the tasks are already overdue.
+namespace bench {
+
+// Reference "now" for generated deadlines: 2025-01-01T00:00:00Z
+inline std::chrono::system_clock::time_point generatorEpoch() {
+    return std::chrono::system_clock::from_time_t(1735689600);
+}
+
+// 'count' tasks with unique names such as "Review deployment plan #42"
+inline std::vector<Task> generateTasks(std::size_t count, unsigned long long seed = 88172645463325252ULL) {
+    static const char* const verbs[] = {"Review", "Write", "Fix", "Deploy", "Benchmark", "Refactor",
+                                        "Document", "Profile", "Migrate", "Test", "Plan", "Train"};
+    static const char* const objects[] = {"deployment plan", "login flow", "kernel tuning", "model weights",
+                                          "CI pipeline", "storage layer", "release notes", "cache policy",
+                                          "API client", "scheduler", "dashboard", "backup job"};
+    Rng rng(seed);
+    std::vector<Task> tasks;
+    tasks.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t roll = rng.below(100);
+        int priority = roll < 30 ? 1 : roll < 75 ? 2 : 3;
+        int hours = static_cast<int>((rng.below(8) + 1) * (rng.below(5) + 1));
+
+        // 60% due within a month, 30% within four months, 10% overdue by up to two weeks
+        roll = rng.below(100);
+        long long days = roll < 60 ? static_cast<long long>(rng.below(30))
+                       : roll < 90 ? static_cast<long long>(rng.below(120))
+                                   : -static_cast<long long>(rng.below(14)) - 1;
+        int hour = rng.below(2) == 0 ? 9 : 17;
+        auto deadline = generatorEpoch() + std::chrono::hours(days * 24 + hour);
+
+        std::string name = verbs[rng.below(sizeof(verbs) / sizeof(verbs[0]))];
+        name += ' ';
+        name += objects[rng.below(sizeof(objects) / sizeof(objects[0]))];
+        name += " #";
+        name += std::to_string(i);
+        tasks.emplace_back(static_cast<TaskKind>(rng.below(TaskKindCount)), std::move(name), priority, hours,
+                           deadline);
+    }
+    return tasks;
+}
+
+// 'count' unique usernames such as "maria.chen17"
+inline std::vector<std::string> generateUsernames(std::size_t count, unsigned long long seed = 2463534242ULL) {
+    static const char* const first[] = {"maria", "li", "ahmed", "sofia", "james", "yuki", "olga", "carlos",
+                                        "amara", "noah", "priya", "lukas"};
+    static const char* const last[] = {"chen", "garcia", "okafor", "smith", "novak", "tanaka", "silva",
+                                       "khan", "muller", "rossi", "kim", "dubois"};
+    Rng rng(seed);
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string name = first[rng.below(sizeof(first) / sizeof(first[0]))];
+        name += '.';
+        name += last[rng.below(sizeof(last) / sizeof(last[0]))];
+        name += std::to_string(i);
+        names.push_back(std::move(name));
+    }
+    return names;
+}
+
+}
+
+#endif
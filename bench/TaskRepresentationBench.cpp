@@ -0,0 +1,90 @@
+// Compares the BaseTask class hierarchy (one heap object per task, virtual
+// accessors) with value-type Task stored inline in a vector.
+//
+// Usage: benchTaskRepresentation [tasks]
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Task.h"
+#include "TaskAdapter.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void report(const char* representation, const char* phase, double seconds, std::size_t count) {
+    std::cout << std::left << std::setw(12) << representation << std::setw(8) << phase << std::right
+              << std::setw(14) << std::fixed << std::setprecision(1) << count / seconds / 1e6 << " M tasks/s\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 5000000);
+
+    // Names are generated up front so both runs pay the same string costs
+    std::vector<std::string> names;
+    names.reserve(count);
+    bench::Rng rng;
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back("task-" + std::to_string(i));
+    }
+    std::vector<int> priorities(count);
+    for (auto& p : priorities) {
+        p = static_cast<int>(rng.below(3)) + 1;
+    }
+
+    {
+        bench::Timer timer;
+        std::vector<std::unique_ptr<BaseTask>> tasks;
+        for (std::size_t i = 0; i < count; ++i) {
+            Task value(static_cast<TaskKind>(i % TaskKindCount), names[i], priorities[i], static_cast<int>(i % 40));
+            tasks.push_back(toBaseTask(value));
+        }
+        report("virtual", "add", timer.seconds(), count);
+
+        timer.reset();
+        std::sort(tasks.begin(), tasks.end(), [](const std::unique_ptr<BaseTask>& a, const std::unique_ptr<BaseTask>& b) {
+            return a->getPriority() > b->getPriority();
+        });
+        report("virtual", "sort", timer.seconds(), count);
+
+        timer.reset();
+        long long hours = 0;
+        for (const auto& task : tasks) {
+            if (task->getPriority() == 3) {
+                hours += task->getEstimatedTime();
+            }
+        }
+        bench::doNotOptimize(hours);
+        report("virtual", "scan", timer.seconds(), count);
+    }
+
+    {
+        bench::Timer timer;
+        std::vector<Task> tasks;
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.emplace_back(static_cast<TaskKind>(i % TaskKindCount), names[i], priorities[i], static_cast<int>(i % 40));
+        }
+        report("value", "add", timer.seconds(), count);
+
+        timer.reset();
+        std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
+            return a.priority > b.priority;
+        });
+        report("value", "sort", timer.seconds(), count);
+
+        timer.reset();
+        long long hours = 0;
+        for (const auto& task : tasks) {
+            if (task.priority == 3) {
+                hours += task.estimatedTime;
+            }
+        }
+        bench::doNotOptimize(hours);
+        report("value", "scan", timer.seconds(), count);
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+// Scheduling overhead of WorkStealingPool for many tiny jobs. Each job only
+// bumps a counter, so the time per job is almost all queueing, stealing and
+// wake-up cost. Rows: one submit() per job, one submitBatch(), jobs spawned
+// from inside the pool (all land on one deque and must be stolen), and
+// TaskManager::run() over tasks with trivial payloads.
+//
+// Usage: benchThreadPool [jobs] [threads]
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TaskManager.h"
+#include "WorkStealingPool.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void report(const char* label, double seconds, std::size_t jobs, const WorkStealingPool& pool) {
+    std::cout << std::left << std::setw(24) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << seconds * 1e9 / jobs << " ns/job"
+              << std::setw(12) << std::setprecision(2) << jobs / seconds / 1e6 << " M jobs/s"
+              << std::setw(10) << pool.steals() << " steals\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t jobs = bench::sizeArg(argc, argv, 1, 1000000);
+    std::size_t threads = bench::sizeArg(argc, argv, 2, std::thread::hardware_concurrency());
+    std::cout << jobs << " jobs on " << threads << " threads\n";
+
+    std::atomic<std::size_t> counter(0);
+    auto tiny = [&counter] { counter.fetch_add(1, std::memory_order_relaxed); };
+
+    {
+        WorkStealingPool pool(threads);
+        bench::Timer timer;
+        for (std::size_t i = 0; i < jobs; ++i) {
+            pool.submit(tiny);
+        }
+        pool.wait();
+        report("submit per job", timer.seconds(), jobs, pool);
+    }
+    {
+        WorkStealingPool pool(threads);
+        std::vector<WorkStealingPool::Job> batch(jobs, tiny);
+        bench::Timer timer;
+        pool.submitBatch(std::move(batch));
+        pool.wait();
+        report("submitBatch", timer.seconds(), jobs, pool);
+    }
+    {
+        WorkStealingPool pool(threads);
+        bench::Timer timer;
+        pool.submit([&] {
+            for (std::size_t i = 0; i < jobs; ++i) {
+                pool.submit(tiny);
+            }
+        });
+        pool.wait();
+        report("spawned in pool", timer.seconds(), jobs, pool);
+    }
+    {
+        TaskManager manager;
+        bench::Rng rng;
+        for (std::size_t i = 0; i < jobs; ++i) {
+            manager.addTask(Task(TaskKind::Hpc, "job-" + std::to_string(i), static_cast<int>(rng.below(3)) + 1, 1), tiny);
+        }
+        WorkStealingPool pool(threads);
+        bench::Timer timer;
+        std::size_t completed = manager.run(pool);
+        report("TaskManager::run", timer.seconds(), completed, pool);
+    }
+
+    bench::doNotOptimize(counter.load());
+    return 0;
+}
@@ -0,0 +1,93 @@
+// Plans 100k open tasks over 52 weeks of weekdays and reports time and
+// plan quality (tasks late, total and priority-weighted lateness in
+// days) for the greedy packer alone and with the local-search pass. The
+// "priority only" row packs in plain priority order, ignoring deadlines.
+//
+// Weekday capacity is set to 'load' percent of the generated demand, as for
+// a team sharing one plan, so some lateness is unavoidable above 100.
+//
+// Usage: benchWeeklyPlanner [tasks] [weeks] [load]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include "WeeklyPlanner.h"
+#include "BenchUtil.h"
+
+namespace {
+
+void report(const char* label, double seconds, const WeeklyPlan& plan) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed
+              << std::setw(9) << std::setprecision(1) << seconds * 1e3 << " ms"
+              << std::setw(9) << plan.plannedTasks << " planned"
+              << std::setw(8) << plan.unscheduled.size() << " left"
+              << std::setw(8) << plan.lateTasks << " late"
+              << std::setw(11) << plan.totalLatenessDays << " days"
+              << std::setw(11) << plan.weightedLatenessDays << " weighted\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = bench::sizeArg(argc, argv, 1, 100000);
+    int weeks = static_cast<int>(bench::sizeArg(argc, argv, 2, 52));
+
+    std::size_t load = bench::sizeArg(argc, argv, 3, 95);
+
+    // Tasks of 1-16 hours with deadlines spread over the year
+    int days = weeks * 7;
+    bench::Rng rng;
+    std::vector<WeeklyPlanner::Item> items;
+    items.reserve(count);
+    long long demand = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        int hours = static_cast<int>(rng.below(16)) + 1;
+        demand += hours;
+        items.push_back(WeeklyPlanner::Item{static_cast<TaskId>(i), static_cast<int>(rng.below(3)) + 1, hours,
+                                            static_cast<int>(rng.below(static_cast<std::size_t>(days)))});
+    }
+
+    PlannerOptions options;
+    options.start = std::chrono::system_clock::time_point(std::chrono::hours(24 * 20000));
+    options.weeks = weeks;
+    int perWeekday = static_cast<int>(demand * 100 / static_cast<long long>(load) / (weeks * 5)) + 1;
+    options.hoursPerDay = {{perWeekday, perWeekday, perWeekday, perWeekday, perWeekday, 0, 0}};
+    WeeklyPlanner planner(options);
+    std::cout << count << " tasks, " << demand << " hours over " << weeks << " weeks, "
+              << perWeekday << " hours per weekday\n";
+
+    PlannerOptions greedyOnly = options;
+    greedyOnly.localSearch = false;
+    bench::Timer timer;
+    WeeklyPlan greedy = WeeklyPlanner(greedyOnly).plan(items);
+    report("greedy", timer.seconds(), greedy);
+
+    timer.reset();
+    WeeklyPlan improved = planner.plan(items);
+    report("greedy + local search", timer.seconds(), improved);
+
+    // Same packer fed in priority order, with every deadline equal
+    std::vector<WeeklyPlanner::Item> byPriority = items;
+    for (WeeklyPlanner::Item& item : byPriority) {
+        item.deadlineDay = 0;
+    }
+    timer.reset();
+    WeeklyPlan naive = WeeklyPlanner(greedyOnly).plan(byPriority);
+    double naiveSeconds = timer.seconds();
+    // Score the naive packing against the real deadlines
+    std::vector<int> finish(count, -1);
+    for (const WeeklyPlan::Slot& slot : naive.slots) {
+        finish[slot.id] = std::max(finish[slot.id], slot.day);
+    }
+    naive.lateTasks = 0;
+    naive.totalLatenessDays = 0;
+    naive.weightedLatenessDays = 0;
+    for (const WeeklyPlanner::Item& item : items) {
+        if (finish[item.id] > item.deadlineDay) {
+            ++naive.lateTasks;
+            naive.totalLatenessDays += finish[item.id] - item.deadlineDay;
+            naive.weightedLatenessDays += static_cast<long long>(item.priority) * (finish[item.id] - item.deadlineDay);
+        }
+    }
+    report("priority only", naiveSeconds, naive);
+    return 0;
+}
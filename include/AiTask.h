@@ -5,9 +5,10 @@
 
 class AiTask : public BaseTask {
 public:
-    AiTask(std::string name, int priority, int estimatedTime);
+    AiTask(std::string_view name, int priority, int estimatedTime);
     
     void displayTask() const override;  // Declaration only
+    TaskKind getKind() const override { return TaskKind::Ai; }
 };
 
 #endif
@@ -2,13 +2,17 @@
 #define BASE_TASK_H
 
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <chrono>
 #include <iomanip> // For formatting output
+#include "TaskKind.h"
+#include "SymbolTable.h"
 
 class BaseTask {
 protected:
-    std::string name; // Task name
+    std::string_view name; // Task name, held in SymbolTable::global() for the task's lifetime
+    Symbol nameSymbol; // Equal names have equal symbols
     int priority; // Task priority (1 = Low, 3 = High)
     std::chrono::system_clock::time_point deadline; // Task deadline
     int estimatedTime; // Estimated time to complete the task (in hours)
@@ -16,14 +20,43 @@ protected:
 
 public:
     // Constructor
-    BaseTask(std::string n, int p, int e) 
-        : name(n), priority(p), estimatedTime(e), isCompleted(false) {}
+    BaseTask(std::string_view n, int p, int e)
+        : priority(p), estimatedTime(e), isCompleted(false) {
+        InternedName interned = SymbolTable::global().intern(n);
+        name = interned.text;
+        nameSymbol = interned.symbol;
+    }
+
+    BaseTask(const BaseTask& other)
+        : name(other.name), nameSymbol(other.nameSymbol), priority(other.priority), deadline(other.deadline),
+          estimatedTime(other.estimatedTime), isCompleted(other.isCompleted) {
+        SymbolTable::global().retain(nameSymbol);
+    }
 
-    virtual ~BaseTask() = default;
+    BaseTask& operator=(const BaseTask& other) {
+        if (this != &other) {
+            SymbolTable::global().retain(other.nameSymbol);
+            SymbolTable::global().release(nameSymbol);
+            name = other.name;
+            nameSymbol = other.nameSymbol;
+            priority = other.priority;
+            deadline = other.deadline;
+            estimatedTime = other.estimatedTime;
+            isCompleted = other.isCompleted;
+        }
+        return *this;
+    }
+
+    virtual ~BaseTask() {
+        SymbolTable::global().release(nameSymbol);
+    }
 
     // Pure virtual function to display task details
     virtual void displayTask() const = 0;
 
+    // Kind of task, used when copying tasks into a TaskStore
+    virtual TaskKind getKind() const = 0;
+
     // Mark the task as completed
     void markAsComplete() {
         isCompleted = true;
@@ -35,7 +68,9 @@ public:
     }
 
     // Accessors for task attributes
-    virtual std::string getName() const { return name; }
+    virtual std::string_view getName() const { return name; }
+    Symbol getNameSymbol() const { return nameSymbol; }
+    bool hasSameName(const BaseTask& other) const { return nameSymbol == other.nameSymbol; }
     virtual int getPriority() const { return priority; }
     virtual int getEstimatedTime() const { return estimatedTime; }
 
@@ -0,0 +1,81 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Task.h"
+#include "TaskRenderer.h"
+
+class UserManager;
+class User;
+
+// Commands accepted by BatchRunner, one per line. Words are separated by
+// spaces or tabs; NAME is the rest of the line, so it may contain spaces.
+//
+//   register USER PASSWORD
+//   login USER PASSWORD
+//   logout
+//   add KIND PRIORITY HOURS DEADLINE NAME
+//   update PRIORITY DEADLINE NAME
+//   complete NAME
+//   remove NAME
+//   list                  tasks of the logged-in user in priority order
+//   deadlines             overdue / due soon / other, as in the interactive menu
+//   sync                  make every change so far durable
+//   checkpoint            fold the log into a fresh snapshot
+//   stats [json]          operation counts and latencies, see OpStats
+//   stats on|off|reset    start or stop recording, or start counting afresh
+//   stats sample N        time one call in N (every call is still counted)
+//
+// KIND, PRIORITY and DEADLINE are parsed like TaskImporter fields; a DEADLINE
+// of "-" leaves the Task default. Blank lines and lines starting with '#'
+// are skipped.
+struct BatchResult {
+    std::size_t commands = 0;
+    std::size_t failed = 0;
+    std::size_t lines = 0;
+    std::size_t firstFailedLine = 0;  // 1-based, 0 if every command succeeded
+};
+
+// Applies a stream of batch commands to a UserManager without any prompts.
+// Input is read in large blocks and scanned in place. Consecutive adds for
+// the same user are collected and applied through User::addTasks, and all
+// output (listings and "line N: ..." errors) is buffered and written a
+// block at a time. Users are only touched through UserManager::withUser, so
+// a script may run while sessions of the same manager are open.
+class BatchRunner {
+private:
+    static constexpr std::size_t MaxPendingTasks = 64 * 1024;
+
+    UserManager& users;
+    std::ostream* out = nullptr;
+    BatchResult result;
+    std::vector<Task> pending;       // Parsed adds not yet applied; slots are reused
+    std::size_t pendingCount = 0;
+    std::shared_ptr<User> pendingOwner;
+    std::unique_ptr<TaskRenderer> output = std::make_unique<TaskRenderer>();  // Listings and errors not yet written
+    std::string scratch;
+
+    void begin(std::ostream& stream);
+    BatchResult finish();
+    void executeLine(std::string_view line);
+    bool execute(std::string_view command, std::string_view args, std::string& error);
+    bool executeForUser(std::string_view command, std::string_view args, User& user, std::string& error);
+    void applyPending();
+    void writeOutput(bool force);
+
+public:
+    explicit BatchRunner(UserManager& userManager) : users(userManager) {}
+
+    // Run every command read from 'in'
+    BatchResult run(std::FILE* in, std::ostream& stream);
+
+    // Run commands already in memory
+    BatchResult runText(std::string_view text, std::ostream& stream);
+};
+
+#endif
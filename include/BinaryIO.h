@@ -0,0 +1,149 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Little-endian encoding helpers shared by the snapshot and log formats.
+// On little-endian hosts whole arrays are copied with a single memcpy.
+namespace binio {
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr bool HostIsLittleEndian = false;
+#else
+constexpr bool HostIsLittleEndian = true;
+#endif
+
+template <typename T>
+inline T byteSwap(T value) {
+    static_assert(std::is_integral<T>::value, "byteSwap needs an integer type");
+    T result;
+    auto* in = reinterpret_cast<const unsigned char*>(&value);
+    auto* out = reinterpret_cast<unsigned char*>(&result);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = in[sizeof(T) - 1 - i];
+    }
+    return result;
+}
+
+// Appends little-endian values to a byte buffer
+class Writer {
+private:
+    std::string& out;
+
+public:
+    explicit Writer(std::string& buffer) : out(buffer) {}
+
+    template <typename T>
+    void put(T value) {
+        if (!HostIsLittleEndian) {
+            value = byteSwap(value);
+        }
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(const T* values, std::size_t count) {
+        if (HostIsLittleEndian) {
+            out.append(reinterpret_cast<const char*>(values), count * sizeof(T));
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                put(values[i]);
+            }
+        }
+    }
+
+    // Length-prefixed string
+    void putString(std::string_view text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        out.append(text.data(), text.size());
+    }
+
+    // Overwrite a value put earlier at byte 'offset', e.g. a count that is
+    // only known once the entries after it are written
+    template <typename T>
+    void putAt(std::size_t offset, T value) {
+        if (!HostIsLittleEndian) {
+            value = byteSwap(value);
+        }
+        std::memcpy(&out[offset], &value, sizeof(T));
+    }
+};
+
+// Reads little-endian values from a byte range. Every read is bounds checked;
+// once a read runs past the end the reader stays failed and returns zeros.
+class Reader {
+private:
+    const char* cursor;
+    const char* end;
+    bool failed = false;
+
+    bool need(std::size_t bytes) {
+        if (failed || static_cast<std::size_t>(end - cursor) < bytes) {
+            failed = true;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    Reader(const char* data, std::size_t size) : cursor(data), end(data + size) {}
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (need(sizeof(T))) {
+            std::memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+        }
+        return HostIsLittleEndian ? value : byteSwap(value);
+    }
+
+    template <typename T>
+    bool getArray(T* values, std::size_t count) {
+        if (count > static_cast<std::size_t>(end - cursor) / sizeof(T) || !need(count * sizeof(T))) {
+            failed = true;
+            return false;
+        }
+        std::memcpy(values, cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+        if (!HostIsLittleEndian) {
+            for (std::size_t i = 0; i < count; ++i) {
+                values[i] = byteSwap(values[i]);
+            }
+        }
+        return true;
+    }
+
+    // Length-prefixed string, returned as a view into the source bytes
+    std::string_view getString() {
+        std::uint32_t length = get<std::uint32_t>();
+        if (!need(length)) {
+            return std::string_view();
+        }
+        std::string_view text(cursor, length);
+        cursor += length;
+        return text;
+    }
+
+    bool ok() const { return !failed; }
+    bool atEnd() const { return cursor == end; }
+    std::size_t remaining() const { return static_cast<std::size_t>(end - cursor); }
+};
+
+// Read a whole file into memory with a single read call
+bool readFile(const std::string& path, std::string& contents);
+
+bool fileExists(const std::string& path);
+
+// Write a file via a temporary and rename it into place, so readers never
+// observe a partially written file
+bool writeFileAtomically(const std::string& path, const std::string& contents);
+
+}
+
+#endif
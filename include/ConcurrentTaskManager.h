@@ -0,0 +1,57 @@
+#ifndef CONCURRENT_TASK_MANAGER_H
+#define CONCURRENT_TASK_MANAGER_H
+
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "TaskManager.h"
+
+// Thread-safe task manager. Tasks are partitioned into shards by a hash of
+// their name; each shard is a TaskManager behind its own mutex, so writers
+// touching different shards never contend. All tasks sharing a name live in
+// the same shard, so name lookups keep TaskManager's semantics.
+//
+// IDs returned by addTask encode the shard in their low bits, which leaves
+// 32 - log2(shardCount) bits for the task's position in its shard. Once a
+// shard has used them all (about 67M tasks with 64 shards), addTask fails
+// rather than hand out an ID that collides with another.
+class ConcurrentTaskManager {
+private:
+    // Padded to a cache line so neighbouring shard locks do not false-share
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        TaskManager manager;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shardCount;
+    std::size_t shardBits;
+
+    std::size_t shardFor(std::string_view taskName) const;
+    bool hasIdFor(const Shard& shard) const;
+
+    // Lock every shard in index order for a consistent view
+    std::vector<std::unique_lock<std::mutex>> lockAll() const;
+
+public:
+    // 'shardCount' is rounded up to a power of two
+    explicit ConcurrentTaskManager(std::size_t shardCount = 64);
+
+    // TaskStore::npos, without adding the task, if its shard is out of IDs
+    TaskId addTask(std::unique_ptr<BaseTask> task);
+    TaskId addTask(const Task& task);
+    bool markTaskComplete(const std::string& taskName);
+    bool removeTask(const std::string& taskName);
+
+    // Reports lock all shards for the duration of the call
+    void displayTasks(std::ostream& out) const;
+    void displayTasksByPriority(std::ostream& out) const;
+
+    std::size_t taskCount() const;
+    std::size_t getShardCount() const { return shardCount; }
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef DEADLINE_INDEX_H
+#define DEADLINE_INDEX_H
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+#include "TaskArena.h"
+#include "TaskStore.h"
+
+// Tasks ordered by deadline, so "overdue" and "due before X" queries walk
+// only the k matching entries instead of checking every task.
+class DeadlineIndex {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+private:
+    using Entry = std::pair<TimePoint, TaskId>;
+
+    std::set<Entry, std::less<Entry>, ArenaAllocator<Entry>> entries;
+
+public:
+    // Nodes come from 'arena' when given, otherwise from the heap
+    explicit DeadlineIndex(std::shared_ptr<TaskArena> arena = nullptr)
+        : entries(std::less<Entry>(), ArenaAllocator<Entry>(std::move(arena))) {}
+
+    void insert(TaskId id, TimePoint deadline) { entries.emplace(deadline, id); }
+    // Index tasks first..last-1 of 'store' in one sorted, hinted pass
+    void insertBatch(const TaskStore& store, TaskId first, TaskId last) {
+        std::vector<Entry> batch;
+        batch.reserve(last - first);
+        for (TaskId id = first; id < last; ++id) {
+            if (store.contains(id)) {
+                batch.emplace_back(store.deadline(id), id);
+            }
+        }
+        std::sort(batch.begin(), batch.end());
+        auto hint = entries.end();
+        for (const Entry& entry : batch) {
+            hint = std::next(entries.insert(hint, entry));
+        }
+    }
+
+    void erase(TaskId id, TimePoint deadline) { entries.erase(std::make_pair(deadline, id)); }
+    void clear() { entries.clear(); }
+    std::size_t size() const { return entries.size(); }
+
+    // Index every live task of 'store'
+    void rebuild(const TaskStore& store) {
+        entries.clear();
+        store.forEach([&](TaskId id) {
+            entries.emplace_hint(entries.end(), store.deadline(id), id);
+        });
+    }
+
+    // Call f(id) for tasks whose deadline has passed (deadline < now), earliest first
+    template <typename F>
+    void forEachOverdue(TimePoint now, F f) const {
+        for (auto it = entries.begin(); it != entries.end() && it->first < now; ++it) {
+            f(it->second);
+        }
+    }
+
+    // Call f(id) for tasks with from <= deadline <= to, earliest first
+    template <typename F>
+    void forEachDueBetween(TimePoint from, TimePoint to, F f) const {
+        for (auto it = entries.lower_bound(std::make_pair(from, TaskId(0))); it != entries.end() && it->first <= to; ++it) {
+            f(it->second);
+        }
+    }
+
+    std::vector<TaskId> overdue(TimePoint now) const {
+        std::vector<TaskId> result;
+        forEachOverdue(now, [&](TaskId id) { result.push_back(id); });
+        return result;
+    }
+
+    std::vector<TaskId> dueBetween(TimePoint from, TimePoint to) const {
+        std::vector<TaskId> result;
+        forEachDueBetween(from, to, [&](TaskId id) { result.push_back(id); });
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef DEADLINE_WATCHER_H
+#define DEADLINE_WATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Background timer that calls a callback when a scheduled deadline passes.
+// The worker thread sleeps until the earliest pending deadline instead of
+// polling. Keys are caller-defined (for example a TaskId).
+class DeadlineWatcher {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+    using Callback = std::function<void(std::uint64_t key)>;
+
+private:
+    struct Entry {
+        TimePoint deadline;
+        std::uint64_t key;
+        std::uint64_t generation;  // Must match 'live' for the entry to fire
+
+        bool operator>(const Entry& other) const { return deadline > other.deadline; }
+    };
+
+    Callback onExpired;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;  // Min-heap on deadline
+    std::unordered_map<std::uint64_t, std::uint64_t> live;  // Key -> generation of its pending entry
+    std::uint64_t nextGeneration = 0;
+    bool stopping = false;
+    std::thread worker;
+
+    void run();
+    void dropStaleEntries();
+
+public:
+    explicit DeadlineWatcher(Callback callback);
+    DeadlineWatcher(const DeadlineWatcher&) = delete;
+    DeadlineWatcher& operator=(const DeadlineWatcher&) = delete;
+    ~DeadlineWatcher();
+
+    // Fire 'key' once 'deadline' has passed, replacing any earlier schedule for it.
+    // Deadlines already in the past fire immediately.
+    void schedule(std::uint64_t key, TimePoint deadline);
+
+    // Forget 'key' if it has not fired yet
+    void cancel(std::uint64_t key);
+
+    std::size_t pending();
+
+    // Entries in the heap, counting superseded ones not yet dropped
+    std::size_t queued();
+};
+
+#endif
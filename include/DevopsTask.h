@@ -5,9 +5,10 @@
 
 class DevopsTask : public BaseTask {
 public:
-    DevopsTask(std::string name, int priority, int estimatedTime);
+    DevopsTask(std::string_view name, int priority, int estimatedTime);
     
     void displayTask() const override;  // Declaration only
+    TaskKind getKind() const override { return TaskKind::Devops; }
 };
 
 #endif
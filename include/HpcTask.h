@@ -5,9 +5,10 @@
 
 class HpcTask : public BaseTask {
 public:
-    HpcTask(std::string name, int priority, int estimatedTime);
+    HpcTask(std::string_view name, int priority, int estimatedTime);
 
     void displayTask() const override;  // Declaration only
+    TaskKind getKind() const override { return TaskKind::Hpc; }
 };
 
 #endif
@@ -0,0 +1,103 @@
+#ifndef MAPPED_TASK_STORE_H
+#define MAPPED_TASK_STORE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "BinaryIO.h"
+#include "TaskStore.h"
+
+// Read-only view of tasks in a memory-mapped file. Opening only maps the file
+// and checks its header, so startup cost does not depend on the number of
+// tasks, and pages are read from disk only when a query touches them.
+//
+// File layout (little-endian):
+//   header (32 bytes): u32 magic, u32 version, u64 recordCount, u64 liveCount, u64 namesBytes
+//   recordCount fixed-stride records of RecordSize bytes:
+//     i64 deadline (ns since epoch), u32 nameOffset, u32 nameLength,
+//     i32 priority, i32 estimatedTime, u8 kind, u8 flags, 6 bytes padding
+//   names blob (namesBytes bytes) that nameOffset points into
+// Record i holds TaskId i of the store it was written from, removed tasks included.
+class MappedTaskStore {
+public:
+    using TimePoint = TaskStore::TimePoint;
+
+    static constexpr std::uint32_t Magic = 0x534D4D54; // "TMMS"
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::size_t HeaderSize = 32;
+    static constexpr std::size_t RecordSize = 32;
+
+private:
+    static constexpr std::uint8_t CompletedFlag = 1;
+    static constexpr std::uint8_t RemovedFlag = 2;
+
+    const char* data = nullptr;  // Start of the mapping
+    std::size_t mappedBytes = 0;
+    std::size_t recordCount = 0;
+    std::size_t liveCount = 0;
+    const char* records = nullptr;
+    const char* namesBlob = nullptr;
+    std::size_t namesBytes = 0;
+
+    template <typename T>
+    T field(TaskId id, std::size_t offset) const {
+        T value;
+        std::memcpy(&value, records + static_cast<std::size_t>(id) * RecordSize + offset, sizeof(T));
+        return binio::HostIsLittleEndian ? value : binio::byteSwap(value);
+    }
+
+    std::uint8_t flags(TaskId id) const { return field<std::uint8_t>(id, 25); }
+
+public:
+    MappedTaskStore() = default;
+    MappedTaskStore(const MappedTaskStore&) = delete;
+    MappedTaskStore& operator=(const MappedTaskStore&) = delete;
+    ~MappedTaskStore();
+
+    // Map a file written by write(); returns false if it is missing or malformed
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    // Write 'store' in the mapped layout
+    static bool write(const TaskStore& store, const std::string& path);
+
+    // Same read interface as TaskStore
+    std::size_t capacity() const { return recordCount; }
+    std::size_t size() const { return liveCount; }
+    bool contains(TaskId id) const { return id < recordCount && !(flags(id) & RemovedFlag); }
+
+    std::string_view name(TaskId id) const {
+        std::uint32_t offset = field<std::uint32_t>(id, 8);
+        std::uint32_t length = field<std::uint32_t>(id, 12);
+        if (offset > namesBytes || length > namesBytes - offset) {
+            return std::string_view(); // Corrupt record
+        }
+        return std::string_view(namesBlob + offset, length);
+    }
+    int priority(TaskId id) const { return field<std::int32_t>(id, 16); }
+    int estimatedTime(TaskId id) const { return field<std::int32_t>(id, 20); }
+    TaskKind kind(TaskId id) const { return static_cast<TaskKind>(field<std::uint8_t>(id, 24) % TaskKindCount); }
+    bool isCompleted(TaskId id) const { return flags(id) & CompletedFlag; }
+    TimePoint deadline(TaskId id) const {
+        std::chrono::duration<std::int64_t, std::nano> sinceEpoch(field<std::int64_t>(id, 0));
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(sinceEpoch));
+    }
+
+    // First live task with the given name, or TaskStore::npos. There is no
+    // name index on disk, so this is a linear scan.
+    TaskId findByName(std::string_view taskName) const;
+
+    template <typename F>
+    void forEach(F f) const {
+        for (TaskId id = 0; id < recordCount; ++id) {
+            if (!(flags(id) & RemovedFlag)) {
+                f(id);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef MUTATION_LOG_H
+#define MUTATION_LOG_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "PasswordHash.h"
+#include "TaskStore.h"
+
+class UserManager;
+
+// Kinds of records stored in the mutation log
+enum class MutationType : std::uint8_t {
+    RegisterUser = 1,
+    AddTask = 2,
+    CompleteTask = 3,
+    RemoveTask = 4,
+    UpdateTask = 5
+};
+
+// Append-only write-ahead log of user and task mutations.
+//
+// File layout: u32 magic, u32 version, then records of
+//   u32 bodyLength, u32 checksum (FNV-1a of body),
+//   body: u64 sequence, u8 type, u32-length-prefixed username, type-specific fields
+// A RegisterUser record carries the user's salt and digest (PasswordHash);
+// version 1 logs carried the plaintext password instead.
+// All integers are little-endian. Records are buffered in memory and written
+// with one write and one fdatasync per group of 'groupCommitSize' records.
+//
+// Appends from several threads are serialized by an internal mutex. The
+// compaction handler runs after that mutex is released, on the thread whose
+// append or sync pushed the log past compactionBytes.
+class MutationLog {
+public:
+    struct Options {
+        std::size_t groupCommitSize = 64;                 // Records per fsync (1 = sync every mutation)
+        std::uint64_t compactionBytes = 64ull << 20;      // Log size that triggers a compaction
+    };
+
+    static constexpr std::uint32_t Magic = 0x4C574D54; // "TMWL"
+    static constexpr std::uint32_t Version = 2;
+
+private:
+    Options options;
+    mutable std::mutex mutex;          // Guards everything below except onCompaction
+    std::string path;
+    int fd = -1;
+    std::string pending;               // Encoded records not yet written
+    std::size_t pendingRecords = 0;
+    std::uint64_t fileBytes = 0;       // Bytes durably written to the file
+    std::uint64_t sequence = 0;        // Sequence number of the last record appended
+    std::uint64_t syncCount = 0;
+    std::function<void()> onCompaction; // Called once the log outgrows compactionBytes
+    std::atomic<bool> compacting{false};
+
+    // These expect 'mutex' to be held; endRecord and commitIfDue release it
+    void beginRecord(MutationType type, std::string_view username, std::size_t& bodyStart);
+    void sealRecord(std::size_t bodyStart);
+    void endRecord(std::size_t bodyStart, std::unique_lock<std::mutex>& lock);
+    void commitIfDue(std::unique_lock<std::mutex>& lock);
+    void encodeAddTask(std::string_view username, const TaskStore& store, TaskId id);
+    bool writePending();
+    bool compactionDue() const;
+
+    void compact();
+
+public:
+    MutationLog() = default;
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+    ~MutationLog();
+
+    // Open the log for appending, keeping only its first 'validBytes' bytes
+    // (as reported by replay) so a torn tail from a crash is discarded.
+    bool open(const std::string& logPath, std::uint64_t validBytes, std::uint64_t lastSequence, const Options& opts);
+    void close();
+    bool isOpen() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return fd >= 0;
+    }
+
+    void setCompactionHandler(std::function<void()> handler) { onCompaction = std::move(handler); }
+
+    void appendRegisterUser(std::string_view username, const PasswordHash& password);
+    void appendAddTask(std::string_view username, const TaskStore& store, TaskId id);
+    // Tasks [first, last) as one group: a compaction cannot fall between
+    // them and snapshot rows whose records are not yet in the log
+    void appendAddTasks(std::string_view username, const TaskStore& store, TaskId first, TaskId last);
+    void appendCompleteTask(std::string_view username, std::string_view taskName);
+    void appendRemoveTask(std::string_view username, std::string_view taskName);
+    void appendUpdateTask(std::string_view username, const TaskStore& store, TaskId id);
+
+    // Write and fsync all buffered records
+    bool sync();
+
+    // Drop every record; used after the state has been written to a snapshot
+    bool truncate();
+
+    std::uint64_t lastSequence() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return sequence;
+    }
+    std::uint64_t sizeBytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return fileBytes + pending.size();
+    }
+    std::uint64_t syncs() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return syncCount;
+    }
+
+    // Apply every record after 'afterSequence' to 'manager'. Stops at the first
+    // torn or corrupt record. Reports how many bytes were valid and the last
+    // sequence number seen, and the file's format version (0 if there was no
+    // header). A missing file counts as an empty log.
+    static bool replay(const std::string& logPath, UserManager& manager, std::uint64_t afterSequence,
+                       std::uint64_t& validBytes, std::uint64_t& lastSequence, std::uint32_t& fileVersion);
+};
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef OP_STATS_H
+#define OP_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Operations whose latency is recorded by OpTimer
+enum class Operation : std::uint8_t {
+    AddTask,       // TaskManager / User addTask and addTasks (one sample per call)
+    CompleteTask,  // markTaskComplete
+    ListTasks,     // Task listings, whichever front end renders them
+    Login,         // UserManager::loginUser
+    RegisterUser   // UserManager::registerUser
+};
+
+constexpr int OperationCount = 5;
+
+// Short snake_case name used in the text and JSON dumps
+const char* operationName(Operation operation);
+
+// Merged counters and latency histogram of one operation. 'count' covers
+// every call; the histogram, mean and maximum cover the calls that were
+// timed (see OpStats::setSamplingInterval). The histogram is log-linear in
+// the HDR style: values below 32 ticks get a bucket each, and every power
+// of two above that is split into 16 equal buckets, so any recorded value
+// is known to within 1/16 of itself.
+struct OperationStats {
+    static constexpr int SubBucketBits = 5;
+    static constexpr int HalfSubBuckets = 1 << (SubBucketBits - 1);
+    static constexpr int BucketCount = (64 - SubBucketBits + 2) * HalfSubBuckets;
+
+    std::uint64_t count = 0;
+    std::uint64_t samples = 0;
+    std::uint64_t totalTicks = 0;
+    std::uint64_t maxTicks = 0;
+    std::vector<std::uint64_t> buckets = std::vector<std::uint64_t>(BucketCount, 0);
+    double ticksPerNanosecond = 1;
+
+    static int bucketOf(std::uint64_t ticks) {
+        if (ticks < 2 * HalfSubBuckets) {
+            return static_cast<int>(ticks);
+        }
+        int shift = 63 - __builtin_clzll(ticks) - (SubBucketBits - 1);
+        return shift * HalfSubBuckets + static_cast<int>(ticks >> shift);
+    }
+
+    // Smallest value that falls into 'bucket'
+    static std::uint64_t bucketStart(int bucket) {
+        if (bucket < 2 * HalfSubBuckets) {
+            return static_cast<std::uint64_t>(bucket);
+        }
+        int shift = bucket / HalfSubBuckets - 1;
+        return static_cast<std::uint64_t>(bucket - shift * HalfSubBuckets) << shift;
+    }
+
+    double meanNanoseconds() const;
+    double maxNanoseconds() const { return maxTicks / ticksPerNanosecond; }
+
+    // Latency below which a 'fraction' (0-1) of the timed calls fall
+    double percentileNanoseconds(double fraction) const;
+};
+
+// Everything recorded since start-up or the last OpStats::reset()
+struct StatsSnapshot {
+    bool enabled = false;
+    std::uint32_t samplingInterval = 1;
+    std::array<OperationStats, OperationCount> operations;
+
+    const OperationStats& operator[](Operation operation) const {
+        return operations[static_cast<int>(operation)];
+    }
+
+    // One line per operation that was called: count, mean, p50/p90/p99/p99.9, max
+    void writeText(std::ostream& out) const;
+    void writeJson(std::ostream& out) const;
+};
+
+// Process-wide operation counters and latency histograms for the hot paths
+// in TaskManager, User and UserManager. Each thread records into its own
+// buffer with plain relaxed stores, so recording never contends; snapshot()
+// merges the buffers of all live threads and of threads that have exited.
+//
+// Every call is counted, but only one in 'samplingInterval' calls per
+// thread is timed: two timestamps cost more than many of the operations
+// themselves. Timestamps come from the CPU timestamp counter where there is
+// one and are converted to nanoseconds when read. Recording is off until
+// setEnabled(true); while off, an OpTimer costs one relaxed load.
+class OpStats {
+public:
+    // Counters of one thread; only the owning thread writes them
+    struct ThreadBuffer {
+        struct Counters {
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> totalTicks{0};
+            std::atomic<std::uint64_t> maxTicks{0};
+            std::atomic<std::uint64_t> buckets[OperationStats::BucketCount] = {};
+        };
+        Counters operations[OperationCount];
+        std::uint32_t countdown = 1;  // Calls left until the next timed one
+    };
+
+    static constexpr std::uint32_t DefaultSamplingInterval = 16;
+
+private:
+    static std::atomic<bool> enabledFlag;
+    static std::atomic<std::uint32_t> interval;
+    static inline thread_local ThreadBuffer* localBuffer = nullptr;
+
+    static ThreadBuffer& attachThread();
+
+    static void bump(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+public:
+    static void setEnabled(bool enabled) { enabledFlag.store(enabled, std::memory_order_relaxed); }
+    static bool isEnabled() { return enabledFlag.load(std::memory_order_relaxed); }
+
+    // Time one call in 'calls' per thread (1 times every call)
+    static void setSamplingInterval(std::uint32_t calls) {
+        interval.store(calls == 0 ? 1 : calls, std::memory_order_relaxed);
+    }
+    static std::uint32_t samplingInterval() { return interval.load(std::memory_order_relaxed); }
+
+    static std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Count a call; true if this one should be timed
+    static bool count(Operation operation) {
+        ThreadBuffer* buffer = localBuffer;
+        if (buffer == nullptr) {
+            buffer = &attachThread();
+        }
+        bump(buffer->operations[static_cast<int>(operation)].count, 1);
+        if (--buffer->countdown != 0) {
+            return false;
+        }
+        buffer->countdown = samplingInterval();
+        return true;
+    }
+
+    // Add a timed call to the histogram; follows count() on the same thread
+    static void record(Operation operation, std::uint64_t ticks);
+
+    static StatsSnapshot snapshot();
+
+    // Start counting from zero again
+    static void reset();
+};
+
+// Counts the enclosing scope as one call of 'operation' and, when sampled,
+// records how long it took
+class OpTimer {
+private:
+    Operation operation;
+    std::uint64_t start = 0;
+
+public:
+    explicit OpTimer(Operation op) : operation(op) {
+        if (OpStats::isEnabled() && OpStats::count(op)) {
+            start = OpStats::now();
+        }
+    }
+    OpTimer(const OpTimer&) = delete;
+    OpTimer& operator=(const OpTimer&) = delete;
+
+    ~OpTimer() {
+        if (start != 0) {
+            OpStats::record(operation, OpStats::now() - start);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PASSWORD_HASH_H
+#define PASSWORD_HASH_H
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Salted SHA-256 of a password: digest = SHA-256(salt || password). Only
+// this is kept in memory and written to snapshots and the mutation log, so
+// neither file reveals a password and equal passwords hash differently.
+// A single round is cheap enough to register millions of users; it is not
+// a slow key-derivation function.
+struct PasswordHash {
+    static constexpr std::size_t SaltBytes = 16;
+    static constexpr std::size_t DigestBytes = 32;
+
+    std::array<std::uint8_t, SaltBytes> salt{};
+    std::array<std::uint8_t, DigestBytes> digest{};
+
+    // Hash 'password' under a fresh random salt
+    static PasswordHash create(std::string_view password);
+
+    // Hash 'password' under the given salt
+    static PasswordHash withSalt(const std::array<std::uint8_t, SaltBytes>& salt, std::string_view password);
+
+    // Compares in time independent of where the digests differ
+    bool matches(std::string_view password) const;
+};
+
+// SHA-256 of 'size' bytes at 'data'
+std::array<std::uint8_t, PasswordHash::DigestBytes> sha256(const void* data, std::size_t size);
+
+#endif
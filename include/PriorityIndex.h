@@ -0,0 +1,168 @@
+#ifndef PRIORITY_INDEX_H
+#define PRIORITY_INDEX_H
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <vector>
+#include "TaskArena.h"
+#include "TaskStore.h"
+
+// Tasks kept in display order: priority (high first), then deadline
+// (earliest first), then insertion order (TaskIds grow with insertion).
+// The order is maintained as tasks are added, completed, updated and removed,
+// so reading it never needs a sort and the first k open tasks cost O(k).
+// Open and completed tasks are kept apart so top-k skips finished work.
+class PriorityIndex {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    struct Key {
+        int priority;
+        TimePoint deadline;
+        TaskId id;
+    };
+
+    struct Order {
+        bool operator()(const Key& a, const Key& b) const {
+            if (a.priority != b.priority) {
+                return a.priority > b.priority;
+            }
+            if (a.deadline != b.deadline) {
+                return a.deadline < b.deadline;
+            }
+            return a.id < b.id;
+        }
+    };
+
+private:
+    using KeySet = std::set<Key, Order, ArenaAllocator<Key>>;
+
+    KeySet open;
+    KeySet done;
+
+public:
+    // Nodes come from 'arena' when given, otherwise from the heap
+    explicit PriorityIndex(std::shared_ptr<TaskArena> arena = nullptr)
+        : open(Order(), ArenaAllocator<Key>(arena)), done(Order(), ArenaAllocator<Key>(arena)) {}
+
+    template <typename Store>
+    static Key keyOf(const Store& store, TaskId id) {
+        return Key{store.priority(id), store.deadline(id), id};
+    }
+
+    void insert(const Key& key, bool completed) {
+        (completed ? done : open).insert(key);
+    }
+
+    // Index tasks first..last-1 of 'store'. Keys are sorted once and inserted
+    // with position hints, so a batch appended after existing tasks costs
+    // amortized O(1) per task instead of a tree search each.
+    template <typename Store>
+    void insertBatch(const Store& store, TaskId first, TaskId last) {
+        std::vector<Key> keys;
+        keys.reserve(last - first);
+        for (TaskId id = first; id < last; ++id) {
+            if (store.contains(id)) {
+                keys.push_back(keyOf(store, id));
+            }
+        }
+        std::sort(keys.begin(), keys.end(), Order());
+        auto openHint = open.end();
+        auto doneHint = done.end();
+        for (const Key& key : keys) {
+            if (store.isCompleted(key.id)) {
+                doneHint = std::next(done.insert(doneHint, key));
+            } else {
+                openHint = std::next(open.insert(openHint, key));
+            }
+        }
+    }
+
+    void erase(const Key& key, bool completed) {
+        (completed ? done : open).erase(key);
+    }
+
+    // Move an open task to the completed set
+    void markComplete(const Key& key) {
+        if (open.erase(key) > 0) {
+            done.insert(key);
+        }
+    }
+
+    void update(const Key& before, const Key& after, bool completed) {
+        erase(before, completed);
+        insert(after, completed);
+    }
+
+    void clear() {
+        open.clear();
+        done.clear();
+    }
+
+    template <typename Store>
+    void rebuild(const Store& store) {
+        clear();
+        store.forEach([&](TaskId id) {
+            insert(keyOf(store, id), store.isCompleted(id));
+        });
+    }
+
+    std::size_t size() const { return open.size() + done.size(); }
+    std::size_t openCount() const { return open.size(); }
+
+    // Call f(id) for every task in order, merging open and completed tasks
+    template <typename F>
+    void forEachSorted(F f) const {
+        forEachSortedAfter(nullptr, [&](TaskId id) {
+            f(id);
+            return true;
+        });
+    }
+
+    // Call f(id) in order for the tasks that sort after 'after' (all of them
+    // if null), until f returns false. Finding the start costs O(log n), so
+    // paging through the order never walks the pages already read.
+    template <typename F>
+    void forEachSortedAfter(const Key* after, F f) const {
+        Order before;
+        auto a = after ? open.upper_bound(*after) : open.begin();
+        auto b = after ? done.upper_bound(*after) : done.begin();
+        while (a != open.end() || b != done.end()) {
+            TaskId id = (b == done.end() || (a != open.end() && before(*a, *b))) ? (a++)->id : (b++)->id;
+            if (!f(id)) {
+                return;
+            }
+        }
+    }
+
+    std::vector<TaskId> sorted() const {
+        std::vector<TaskId> ids;
+        ids.reserve(size());
+        forEachSorted([&](TaskId id) { ids.push_back(id); });
+        return ids;
+    }
+
+    // Call f(id) for open tasks in order until f returns false
+    template <typename F>
+    void forEachOpen(F f) const {
+        for (const Key& key : open) {
+            if (!f(key.id)) {
+                return;
+            }
+        }
+    }
+
+    // The k highest-ranked open tasks
+    std::vector<TaskId> top(std::size_t k) const {
+        std::vector<TaskId> ids;
+        for (auto it = open.begin(); it != open.end() && ids.size() < k; ++it) {
+            ids.push_back(it->id);
+        }
+        return ids;
+    }
+};
+
+#endif
@@ -5,9 +5,10 @@
 
 class ProgrammingTask : public BaseTask {
 public:
-    ProgrammingTask(std::string name, int priority, int estimatedTime);
+    ProgrammingTask(std::string_view name, int priority, int estimatedTime);
 
     void displayTask() const override;  // Declaration only
+    TaskKind getKind() const override { return TaskKind::Programming; }
 };
 
 #endif
@@ -0,0 +1,140 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "TaskStore.h"
+
+// How the scheduler orders open tasks
+enum class SchedulePolicy : std::uint8_t {
+    EarliestDeadline,     // EDF: earliest deadline first
+    WeightedShortestJob,  // WSJF: highest priority / estimatedTime first
+    Hybrid                // WSJF, but tasks due within the starvation horizon go first, EDF among themselves
+};
+
+struct ScheduleOptions {
+    SchedulePolicy policy = SchedulePolicy::Hybrid;
+    std::chrono::system_clock::time_point start = std::chrono::system_clock::now();  // When work begins
+    std::chrono::hours starvationHorizon{24};  // Hybrid only
+};
+
+// One task's slot in the plan; times are hours after ScheduleOptions::start
+struct PlannedTask {
+    TaskId id;
+    double startHours;
+    double finishHours;
+    double latenessHours;  // 0 when the task finishes by its deadline
+};
+
+struct ScheduleSummary {
+    std::size_t tasks = 0;
+    std::size_t lateTasks = 0;
+    double totalLatenessHours = 0;
+    double maxLatenessHours = 0;
+};
+
+// Execution plan for a set of open tasks run back to back, one at a time,
+// with each task taking its estimatedTime in hours. Predicted lateness is
+// how far each task would finish past its deadline.
+//
+// Changes are queued by add/remove and applied on the next read. Only the
+// part of the plan from the first affected position onward is merged and
+// re-timed; everything before it is kept as is.
+class Scheduler {
+private:
+    static constexpr std::uint32_t NotPlanned = 0xFFFFFFFFu;
+
+    struct Entry {
+        double rank;            // Smaller runs first
+        double deadlineHours;   // Tie-break, then lateness
+        TaskId id;
+        std::int32_t priority;
+        std::int32_t estimatedTime;
+        std::uint32_t generation;  // Entry is stale unless this matches generations[id]
+        std::uint8_t band;      // Hybrid: 0 for tasks inside the starvation horizon
+    };
+
+    struct Before {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.band != b.band) {
+                return a.band < b.band;
+            }
+            if (a.rank != b.rank) {
+                return a.rank < b.rank;
+            }
+            if (a.deadlineHours != b.deadlineHours) {
+                return a.deadlineHours < b.deadlineHours;
+            }
+            return a.id < b.id;
+        }
+    };
+
+    ScheduleOptions options;
+    std::vector<Entry> plan;               // Execution order, may hold stale entries until replan
+    std::vector<double> finishHours;       // Per plan position
+    std::vector<double> latenessTotals;    // Running sum of lateness up to each position
+    std::vector<double> latenessMaxima;    // Running maximum of lateness up to each position
+    std::vector<std::uint32_t> lateCounts; // Running count of late tasks up to each position
+    std::vector<std::uint32_t> generations;  // Per TaskId
+    std::vector<std::uint32_t> positions;    // Per TaskId, NotPlanned if absent
+    std::vector<Entry> pending;            // Added since the last replan
+    std::size_t dirtyFrom = 0;             // First plan position affected by a pending change
+    std::size_t replanned = 0;             // Positions re-timed by the last replan
+
+    // Fills in the rank and band of an entry from its other fields
+    void rank(Entry& entry) const;
+    void invalidate(TaskId id);
+    void replan();
+    PlannedTask planned(std::size_t position) const;
+
+public:
+    explicit Scheduler(const ScheduleOptions& opts = ScheduleOptions());
+
+    // Add an open task, or re-plan one whose priority, deadline or estimate changed
+    void add(TaskId id, int priority, int estimatedTime, std::chrono::system_clock::time_point deadline);
+
+    // Drop a task that was completed or removed
+    void remove(TaskId id);
+
+    // Replace the plan with every open task in 'store'
+    template <typename Store>
+    void rebuild(const Store& store) {
+        plan.clear();
+        pending.clear();
+        dirtyFrom = 0;
+        generations.assign(store.capacity(), 0);
+        positions.assign(store.capacity(), NotPlanned);
+        store.forEach([&](TaskId id) {
+            if (!store.isCompleted(id)) {
+                add(id, store.priority(id), store.estimatedTime(id), store.deadline(id));
+            }
+        });
+    }
+
+    // Switch policy, horizon or start time; the whole plan is rebuilt on the next read
+    void setOptions(const ScheduleOptions& opts);
+    const ScheduleOptions& getOptions() const { return options; }
+
+    std::size_t size();
+    ScheduleSummary summary();
+
+    // Call f(const PlannedTask&) in execution order
+    template <typename F>
+    void forEach(F f) {
+        replan();
+        for (std::size_t i = 0; i < plan.size(); ++i) {
+            f(planned(i));
+        }
+    }
+
+    std::vector<TaskId> order();
+
+    // Look up a task's slot; false if it is not planned
+    bool find(TaskId id, PlannedTask& slot);
+
+    // How many plan positions the most recent re-plan had to re-time
+    std::size_t lastReplanSize() const { return replanned; }
+};
+
+#endif
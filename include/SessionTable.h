@@ -0,0 +1,52 @@
+#ifndef SESSION_TABLE_H
+#define SESSION_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class User;
+
+// Opaque handle to a login; 0 is never issued
+using SessionToken = std::uint64_t;
+
+// Open sessions, each mapping a random token to the User that logged in.
+// Sessions are partitioned into shards by the low bits of their token; each
+// shard is a hash map behind its own mutex, so threads resolving different
+// sessions rarely meet on a lock. A user may hold any number of sessions.
+class SessionTable {
+public:
+    static constexpr SessionToken NoSession = 0;
+
+private:
+    // Padded to a cache line so neighbouring shard locks do not false-share
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::unordered_map<SessionToken, std::shared_ptr<User>> sessions;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shardMask;
+
+    Shard& shardFor(SessionToken token) const { return shards[token & shardMask]; }
+
+public:
+    // 'shardCount' is rounded up to a power of two
+    explicit SessionTable(std::size_t shardCount = 64);
+    SessionTable(const SessionTable&) = delete;
+    SessionTable& operator=(const SessionTable&) = delete;
+
+    SessionToken open(std::shared_ptr<User> user);
+
+    // False if 'token' was not open
+    bool close(SessionToken token);
+
+    // User behind 'token', or null if the session is not open
+    std::shared_ptr<User> find(SessionToken token) const;
+
+    void clear();
+    std::size_t size() const;
+};
+
+#endif
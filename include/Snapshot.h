@@ -0,0 +1,40 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class UserManager;
+
+// Versioned binary snapshot of every user and their tasks.
+//
+// All integers are little-endian. Layout (version 3):
+//   u32 magic, u32 version, u64 logSequence, u32 stringCount, u32 userCount
+//   string table: stringCount x (u32 length, bytes)  -- usernames, task names
+//   per user:
+//     u32 username (string table index), u8 salt[16], u8 digest[32] (see PasswordHash),
+//     u32 rowCount
+//     u32 name[rowCount], i32 priority[rowCount], i32 estimatedTime[rowCount],
+//     i64 deadline[rowCount] (ns since epoch), u8 flags[rowCount], u8 kind[rowCount]
+//
+// Each column is stored contiguously so loading is a handful of bulk copies
+// per user. Removed tasks are kept as rows so task IDs survive a round trip.
+// logSequence is the last mutation log record already reflected in the
+// snapshot; version 1 files have no such field and read as 0. Versions 1
+// and 2 stored plaintext passwords in the string table (a u32 index in
+// place of salt and digest); they are hashed as they are loaded.
+class SnapshotCodec {
+public:
+    static constexpr std::uint32_t Magic = 0x50534D54; // "TMSP"
+    static constexpr std::uint32_t Version = 3;
+    static constexpr std::size_t UserHeaderBytes = 4 + 16 + 32 + 4;
+
+    static void encode(const UserManager& manager, std::string& out);
+
+    // Replace the users in 'manager' with the snapshot contents.
+    // Returns false, leaving 'manager' untouched, if the data is malformed.
+    static bool decode(std::string_view data, UserManager& manager);
+};
+
+#endif
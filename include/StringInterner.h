@@ -0,0 +1,149 @@
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compact handle for an interned string
+using Symbol = std::uint32_t;
+
+// Maps strings to dense 32-bit symbols. Each distinct string is stored once;
+// symbols are handed out in insertion order starting at 0.
+//
+// String bytes are packed into large chunks (one allocation per chunk rather
+// than per string) and looked up through an open-addressing table of symbols,
+// so interning millions of names costs few mallocs and few cache misses.
+class StringInterner {
+private:
+    static constexpr std::size_t ChunkSize = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks;  // Never moved once allocated
+    std::size_t chunkUsed = ChunkSize;            // Bytes used in chunks.back()
+    std::vector<std::unique_ptr<char[]>> largeStrings;
+    std::vector<std::string_view> strings;        // Symbol -> text (points into chunks)
+    std::vector<std::uint32_t> hashes;            // Symbol -> hash of its text
+    std::vector<Symbol> slots;                    // Hash table of symbol + 1 (0 = empty)
+
+    static std::uint32_t hashOf(std::string_view text) {
+        return static_cast<std::uint32_t>(std::hash<std::string_view>()(text));
+    }
+
+    // Slot holding 'text', or the empty slot where it would go
+    std::size_t probe(std::string_view text, std::uint32_t hash) const {
+        std::size_t mask = slots.size() - 1;
+        for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+            Symbol entry = slots[slot];
+            if (entry == 0 || (hashes[entry - 1] == hash && strings[entry - 1] == text)) {
+                return slot;
+            }
+        }
+    }
+
+    void rehash(std::size_t slotCount) {
+        slots.assign(slotCount, 0);
+        std::size_t mask = slotCount - 1;
+        for (Symbol symbol = 0; symbol < strings.size(); ++symbol) {
+            std::size_t slot = hashes[symbol] & mask;
+            while (slots[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            slots[slot] = symbol + 1;
+        }
+    }
+
+    std::string_view store(std::string_view text) {
+        if (text.empty()) {
+            return std::string_view();
+        }
+        char* data;
+        if (text.size() > ChunkSize / 4) {
+            // Large strings get an allocation of their own
+            largeStrings.push_back(std::make_unique<char[]>(text.size()));
+            data = largeStrings.back().get();
+        } else {
+            if (ChunkSize - chunkUsed < text.size()) {
+                chunks.push_back(std::make_unique<char[]>(ChunkSize));
+                chunkUsed = 0;
+            }
+            data = chunks.back().get() + chunkUsed;
+            chunkUsed += text.size();
+        }
+        std::memcpy(data, text.data(), text.size());
+        return std::string_view(data, text.size());
+    }
+
+public:
+    static constexpr Symbol npos = static_cast<Symbol>(-1);
+
+    StringInterner() = default;
+    StringInterner(StringInterner&&) = default;
+    StringInterner& operator=(StringInterner&&) = default;
+
+    StringInterner(const StringInterner& other) {
+        reserve(other.size());
+        for (std::string_view text : other.strings) {
+            intern(text);
+        }
+    }
+
+    StringInterner& operator=(const StringInterner& other) {
+        if (this != &other) {
+            StringInterner copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    void reserve(std::size_t count) {
+        strings.reserve(count);
+        hashes.reserve(count);
+        std::size_t slotCount = 16;
+        while (slotCount < count * 2) {
+            slotCount *= 2;
+        }
+        if (slotCount > slots.size()) {
+            rehash(slotCount);
+        }
+    }
+
+    // Return the symbol for 'text', interning it if needed
+    Symbol intern(std::string_view text) {
+        if ((strings.size() + 1) * 2 > slots.size()) {
+            rehash(slots.empty() ? 16 : slots.size() * 2);
+        }
+        std::uint32_t hash = hashOf(text);
+        std::size_t slot = probe(text, hash);
+        if (slots[slot] != 0) {
+            return slots[slot] - 1;
+        }
+        Symbol symbol = static_cast<Symbol>(strings.size());
+        strings.push_back(store(text));
+        hashes.push_back(hash);
+        slots[slot] = symbol + 1;
+        return symbol;
+    }
+
+    // Return the symbol for 'text', or npos if it was never interned
+    Symbol find(std::string_view text) const {
+        if (slots.empty()) {
+            return npos;
+        }
+        Symbol entry = slots[probe(text, hashOf(text))];
+        return entry != 0 ? entry - 1 : npos;
+    }
+
+    std::string_view view(Symbol symbol) const {
+        return strings[symbol];
+    }
+
+    std::size_t size() const {
+        return strings.size();
+    }
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "StringInterner.h"
+
+// An interned string: its symbol plus a view of the pooled text. The text
+// stays put while any holder of the symbol remains.
+struct InternedName {
+    Symbol symbol = StringInterner::npos;
+    std::string_view text;
+};
+
+// Thread-safe, reference-counted interning pool for names held by long-lived
+// objects (task objects, users). Equal names get equal symbols, so names
+// compare and hash as integers. Lookups of already-interned names take only
+// a shared lock.
+//
+// Every intern() or retain() is matched by a release(). When the last holder
+// of a name releases it, its text is freed and its symbol may be handed to a
+// different name later, so a symbol is only meaningful while held. What
+// stays behind is one free-list slot per symbol ever live at once.
+class SymbolTable {
+private:
+    struct Entry {
+        std::unique_ptr<char[]> text;  // Null while the symbol is free
+        std::size_t length = 0;
+        std::atomic<std::uint32_t> holders{0};
+
+        std::string_view view() const { return std::string_view(text.get(), length); }
+    };
+
+    mutable std::shared_mutex mutex;
+    std::deque<Entry> entries;  // Indexed by symbol; entries never move
+    std::unordered_map<std::string_view, Symbol> symbols;  // Views the entries' text
+    std::vector<Symbol> freeSymbols;
+
+public:
+    // The pool shared by BaseTask and User. Never destroyed, so objects
+    // released during static destruction still find it.
+    static SymbolTable& global() {
+        static SymbolTable* table = new SymbolTable();
+        return *table;
+    }
+
+    // Intern 'text' and hold it until the matching release()
+    InternedName intern(std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = symbols.find(text);
+            if (it != symbols.end()) {
+                Entry& entry = entries[it->second];
+                entry.holders.fetch_add(1, std::memory_order_relaxed);
+                return InternedName{it->second, entry.view()};
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = symbols.find(text);
+        if (it != symbols.end()) {
+            Entry& entry = entries[it->second];
+            entry.holders.fetch_add(1, std::memory_order_relaxed);
+            return InternedName{it->second, entry.view()};
+        }
+        Symbol symbol;
+        if (!freeSymbols.empty()) {
+            symbol = freeSymbols.back();
+            freeSymbols.pop_back();
+        } else {
+            symbol = static_cast<Symbol>(entries.size());
+            entries.emplace_back();
+        }
+        Entry& entry = entries[symbol];
+        entry.text = std::make_unique<char[]>(text.size());
+        std::memcpy(entry.text.get(), text.data(), text.size());
+        entry.length = text.size();
+        entry.holders.store(1, std::memory_order_relaxed);
+        symbols.emplace(entry.view(), symbol);
+        return InternedName{symbol, entry.view()};
+    }
+
+    // Hold 'symbol' once more, e.g. for a copy of its holder
+    void retain(Symbol symbol) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        entries[symbol].holders.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Drop one hold on 'symbol'; the last one frees the name
+    void release(Symbol symbol) {
+        if (symbol == StringInterner::npos) {
+            return;
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (entries[symbol].holders.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+        }
+        // Another thread may have interned the name again meanwhile, or
+        // already freed it after a hold of its own came and went
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        Entry& entry = entries[symbol];
+        if (entry.text && entry.holders.load(std::memory_order_acquire) == 0) {
+            symbols.erase(entry.view());
+            entry.text.reset();
+            entry.length = 0;
+            freeSymbols.push_back(symbol);
+        }
+    }
+
+    // Symbol of 'text', or StringInterner::npos if no one holds it
+    Symbol find(std::string_view text) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = symbols.find(text);
+        return it != symbols.end() ? it->second : StringInterner::npos;
+    }
+
+    std::string_view view(Symbol symbol) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return entries[symbol].view();
+    }
+
+    // Names currently held
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return symbols.size();
+    }
+};
+
+#endif
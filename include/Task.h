@@ -0,0 +1,52 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include <string>
+#include <chrono>
+#include <ctime>
+#include <ostream>
+#include "TaskKind.h"
+
+// Value-type task. The kind is a one-byte tag instead of a subclass, so tasks
+// can be stored inline in contiguous containers and copied or moved freely.
+struct Task {
+    std::string name; // Task name
+    TaskKind kind = TaskKind::Ai; // Kind of task
+    int priority = 1; // Task priority (1 = Low, 3 = High)
+    int estimatedTime = 0; // Estimated time to complete the task (in hours)
+    bool isCompleted = false; // Flag to mark if the task is completed
+    std::chrono::system_clock::time_point deadline; // Task deadline
+
+    Task() = default;
+
+    Task(TaskKind k, std::string n, int p, int e,
+         std::chrono::system_clock::time_point dl = std::chrono::system_clock::time_point())
+        : name(std::move(n)), kind(k), priority(p), estimatedTime(e), deadline(dl) {}
+
+    bool isOverdue(std::chrono::system_clock::time_point now) const {
+        return now > deadline;
+    }
+
+    // Write the task in the same format as BaseTask::displayTask, without a newline
+    void print(std::ostream& out) const {
+        visitKind(kind, [&](auto tag) {
+            printAs<decltype(tag)::value>(out);
+        });
+    }
+
+    // Kind-specific printer selected at compile time
+    template <TaskKind K>
+    void printAs(std::ostream& out) const {
+        std::time_t deadlineTime = std::chrono::system_clock::to_time_t(deadline);
+        char buffer[26]; // Buffer to hold formatted time
+        ctime_r(&deadlineTime, buffer); // Thread-safe version of ctime
+        buffer[24] = '\0'; // Remove trailing newline
+        out << TaskKindTraits<K>::label << ": " << name
+            << " | Priority: " << priority
+            << " | Deadline: " << buffer
+            << " | Estimated Time: " << estimatedTime << " hours"
+            << " | Completed: " << (isCompleted ? "Yes" : "No");
+    }
+};
+
+#endif
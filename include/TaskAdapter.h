@@ -0,0 +1,41 @@
+#ifndef TASK_ADAPTER_H
+#define TASK_ADAPTER_H
+
+#include <memory>
+#include "Task.h"
+#include "AiTask.h"
+#include "HpcTask.h"
+#include "ProgrammingTask.h"
+#include "DevopsTask.h"
+
+// Bridges between value-type Task and the BaseTask class hierarchy, for code
+// that still passes tasks around as std::unique_ptr<BaseTask>.
+
+// Subclass of BaseTask that represents each kind
+template <TaskKind K> struct LegacyTaskType;
+template <> struct LegacyTaskType<TaskKind::Ai> { using type = AiTask; };
+template <> struct LegacyTaskType<TaskKind::Hpc> { using type = HpcTask; };
+template <> struct LegacyTaskType<TaskKind::Programming> { using type = ProgrammingTask; };
+template <> struct LegacyTaskType<TaskKind::Devops> { using type = DevopsTask; };
+
+// Copy a BaseTask into a value-type Task
+inline Task toTask(const BaseTask& task) {
+    Task result(task.getKind(), std::string(task.getName()), task.getPriority(), task.getEstimatedTime(), task.getDeadline());
+    result.isCompleted = task.isTaskCompleted();
+    return result;
+}
+
+// Build the matching BaseTask subclass for a value-type Task
+inline std::unique_ptr<BaseTask> toBaseTask(const Task& task) {
+    std::unique_ptr<BaseTask> result = visitKind(task.kind, [&](auto tag) -> std::unique_ptr<BaseTask> {
+        using Legacy = typename LegacyTaskType<decltype(tag)::value>::type;
+        return std::make_unique<Legacy>(task.name, task.priority, task.estimatedTime);
+    });
+    result->setDeadline(task.deadline);
+    if (task.isCompleted) {
+        result->markAsComplete();
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef TASK_ARENA_H
+#define TASK_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+// Slab allocator for the small per-task blocks a TaskManager or User creates,
+// such as index nodes. Blocks are carved out of 64 KiB slabs, so a thousand
+// tasks cost a handful of mallocs instead of one each. Freed blocks go on a
+// free list per size and are reused; the slabs themselves are released all at
+// once when the arena is destroyed. Not thread-safe.
+class TaskArena {
+private:
+    static constexpr std::size_t SlabSize = 64 * 1024;
+    static constexpr std::size_t Alignment = alignof(std::max_align_t);
+    static constexpr std::size_t MaxBlock = SlabSize / 16;  // Larger blocks bypass the arena
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::vector<std::unique_ptr<std::max_align_t[]>> slabs;
+    std::size_t slabUsed = SlabSize;                 // Bytes used in slabs.back()
+    std::vector<FreeBlock*> freeLists;               // Per size class (bytes / Alignment)
+    std::size_t liveBlocks = 0;
+
+    static std::size_t sizeClass(std::size_t bytes) {
+        return (bytes + Alignment - 1) / Alignment;
+    }
+
+public:
+    TaskArena() : freeLists(MaxBlock / Alignment + 1, nullptr) {}
+    TaskArena(const TaskArena&) = delete;
+    TaskArena& operator=(const TaskArena&) = delete;
+
+    void* allocate(std::size_t bytes) {
+        if (bytes > MaxBlock) {
+            return ::operator new(bytes);
+        }
+        std::size_t sizeIndex = sizeClass(bytes);
+        ++liveBlocks;
+        if (FreeBlock* block = freeLists[sizeIndex]) {
+            freeLists[sizeIndex] = block->next;
+            return block;
+        }
+        std::size_t rounded = sizeIndex * Alignment;
+        if (SlabSize - slabUsed < rounded) {
+            slabs.emplace_back(new std::max_align_t[SlabSize / sizeof(std::max_align_t)]);
+            slabUsed = 0;
+        }
+        void* block = reinterpret_cast<char*>(slabs.back().get()) + slabUsed;
+        slabUsed += rounded;
+        return block;
+    }
+
+    void deallocate(void* pointer, std::size_t bytes) {
+        if (bytes > MaxBlock) {
+            ::operator delete(pointer);
+            return;
+        }
+        std::size_t sizeIndex = sizeClass(bytes);
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeLists[sizeIndex];
+        freeLists[sizeIndex] = block;
+        --liveBlocks;
+    }
+
+    // Number of slabs obtained from the system so far
+    std::size_t slabCount() const { return slabs.size(); }
+
+    // Blocks handed out and not yet returned
+    std::size_t liveBlockCount() const { return liveBlocks; }
+};
+
+// Standard allocator over a shared TaskArena, for node-based containers.
+// A default-constructed allocator uses the global heap. Containers sharing an
+// arena must be used from one thread at a time.
+template <typename T>
+class ArenaAllocator {
+private:
+    std::shared_ptr<TaskArena> arena;
+
+    template <typename U> friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(std::shared_ptr<TaskArena> a) : arena(std::move(a)) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(std::size_t count) {
+        if (!arena) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(arena->allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) {
+        if (!arena) {
+            ::operator delete(pointer);
+            return;
+        }
+        arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    const std::shared_ptr<TaskArena>& getArena() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef TASK_CLIENT_H
+#define TASK_CLIENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Task.h"
+#include "TaskProtocol.h"
+
+// A task as returned by ListTasks
+struct RemoteTask {
+    std::uint32_t id = 0;
+    Task task;
+};
+
+// Blocking client for TaskServer. Requests are encoded into a local buffer
+// by the send* calls and only written by flush(), so any number of them can
+// be pipelined in one write; receive() then reads the responses in the
+// same order. The call() helpers send one request and wait for its answer.
+class TaskClient {
+public:
+    struct Response {
+        std::uint32_t requestId = 0;
+        protocol::Status status = protocol::Status::BadRequest;
+        std::string fields;  // Result fields, decode with binio::Reader
+    };
+
+private:
+    int fd = -1;
+    std::uint32_t nextRequestId = 1;
+    std::string output;
+    std::string input;
+    std::size_t inputOffset = 0;
+
+    std::size_t beginRequest(protocol::Opcode opcode);
+
+public:
+    TaskClient() = default;
+    TaskClient(const TaskClient&) = delete;
+    TaskClient& operator=(const TaskClient&) = delete;
+    ~TaskClient();
+
+    bool connectUnix(const std::string& path);
+    bool connectTcp(const std::string& host, int port);
+    bool isConnected() const { return fd >= 0; }
+    void disconnect();
+
+    // Queue a request; returns its request ID
+    std::uint32_t sendRegister(std::string_view username, std::string_view password);
+    std::uint32_t sendLogin(std::string_view username, std::string_view password);
+    std::uint32_t sendLogout();
+    std::uint32_t sendAddTask(const Task& task);
+    std::uint32_t sendMarkTaskComplete(std::string_view name);
+    // One page of tasks, resuming after 'after' (from the start if null)
+    std::uint32_t sendListTasks(std::uint32_t limit = 0, const RemoteTask* after = nullptr);
+
+    // Write every queued request; false if the connection failed
+    bool flush();
+
+    // Wait for the next response; false if the connection closed or failed
+    bool receive(Response& response);
+
+    // Synchronous helpers; a broken connection reports BadRequest
+    protocol::Status registerUser(std::string_view username, std::string_view password);
+    protocol::Status login(std::string_view username, std::string_view password);
+    protocol::Status addTask(const Task& task, std::uint32_t* taskId = nullptr);
+    protocol::Status markTaskComplete(std::string_view name);
+    // Every task, fetched a page at a time
+    protocol::Status listTasks(std::vector<RemoteTask>& tasks);
+
+    // Decode the fields of a ListTasks response into 'tasks' (one page);
+    // 'total', if given, receives the user's task count and 'more' whether
+    // tasks remain after this page
+    static bool decodeTaskList(std::string_view fields, std::vector<RemoteTask>& tasks,
+                               std::uint32_t* total = nullptr, bool* more = nullptr);
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+#include "TaskStore.h"
+
+// Longest chain of open tasks, by estimatedTime
+struct CriticalPath {
+    int length = 0;              // Hours to finish all open work with unlimited workers
+    std::vector<TaskId> tasks;   // The chain, first task first
+};
+
+// Dependency DAG over TaskIds. An edge prerequisite -> task means the task
+// cannot start until the prerequisite is complete.
+//
+// A topological order is kept up to date as edges are added (Pearce-Kelly):
+// only the nodes between the two endpoints' positions are visited and
+// reordered, and an edge that would close a cycle is rejected.
+//
+// Each task counts its incomplete prerequisites, so completing a task touches
+// only its dependents and newly runnable tasks are queued for popReady.
+class TaskGraph {
+private:
+    static constexpr std::uint32_t NoPosition = 0xFFFFFFFFu;
+
+    std::vector<std::vector<TaskId>> dependents;     // Out-edges
+    std::vector<std::vector<TaskId>> prerequisites;  // In-edges
+    std::vector<std::uint32_t> waitingOn;            // Incomplete prerequisites per task
+    std::vector<int> estimatedTimes;
+    std::vector<std::uint8_t> states;                // StateFlags per task
+    std::vector<std::uint32_t> positions;            // Task -> index in topoOrder
+    std::vector<TaskId> topoOrder;                   // Every task ever added, in topological order
+    std::vector<TaskId> readyQueue;                  // Tasks that became runnable; may hold stale entries
+    std::size_t readyHead = 0;
+    std::size_t edgeCount = 0;
+
+    // Scratch space for reordering, kept to avoid reallocating per edge
+    std::vector<std::uint8_t> visited;
+    std::vector<TaskId> forward;
+    std::vector<TaskId> backward;
+    std::vector<TaskId> stack;
+
+    enum StateFlags : std::uint8_t { Present = 1, Done = 2, HandedOut = 4 };
+
+    bool has(TaskId id, std::uint8_t flag) const { return id < states.size() && (states[id] & flag) != 0; }
+    bool reorder(TaskId prerequisite, TaskId task);
+    void release(TaskId id, std::vector<TaskId>* released);
+
+public:
+    // Make room for tasks with IDs below 'count'; grows at least geometrically
+    void reserve(std::size_t count);
+
+    // Register a task; completed tasks never block their dependents
+    void addTask(TaskId id, int estimatedTime, bool completed = false);
+
+    // Make 'task' wait for 'prerequisite'. Fails (leaving the graph unchanged)
+    // for unknown tasks, self-dependencies and edges that would form a cycle.
+    // Adding an existing edge again succeeds without duplicating it.
+    bool addDependency(TaskId task, TaskId prerequisite);
+
+    // Mark a task complete and release its dependents. Newly runnable tasks
+    // are queued for popReady and, if given, appended to 'released'.
+    void markComplete(TaskId id, std::vector<TaskId>* released = nullptr);
+
+    // Forget a task; its dependents no longer wait for it
+    void removeTask(TaskId id, std::vector<TaskId>* released = nullptr);
+
+    bool contains(TaskId id) const { return has(id, Present); }
+    bool isComplete(TaskId id) const { return has(id, Done); }
+
+    // Present, incomplete and not waiting on anything
+    bool isReady(TaskId id) const {
+        return has(id, Present) && !has(id, Done) && waitingOn[id] == 0;
+    }
+
+    // Next runnable task not yet handed out, oldest first
+    bool popReady(TaskId& id);
+
+    const std::vector<TaskId>& dependenciesOf(TaskId id) const { return prerequisites[id]; }
+    const std::vector<TaskId>& dependentsOf(TaskId id) const { return dependents[id]; }
+    std::size_t dependencyCount() const { return edgeCount; }
+
+    // Present tasks with every prerequisite before its dependents
+    std::vector<TaskId> topologicalOrder() const;
+
+    // Earliest finish of every open task, in hours from now, if all runnable
+    // work started at once; indexed by TaskId, 0 for complete or absent tasks
+    std::vector<int> earliestFinishTimes() const;
+
+    CriticalPath criticalPath() const;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef TASK_IMPORTER_H
+#define TASK_IMPORTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Task.h"
+
+class UserManager;
+class WorkStealingPool;
+
+// Input formats accepted by TaskImporter. Both carry one task per line with
+// the fields name, kind, priority, estimatedTime, deadline and owner.
+//
+//   Csv:       name,kind,priority,estimatedTime,deadline,owner
+//              Fields may be double-quoted ("" inside quotes is a quote) but
+//              may not span lines. A first line starting with "name," is a header.
+//   JsonLines: {"name":"...","kind":"hpc","priority":2,"estimatedTime":5,
+//               "deadline":"2025-03-01T09:00:00Z","owner":"alice"}
+//              Keys may come in any order; unknown keys with scalar values are ignored.
+//
+// kind is ai, hpc, programming or devops (any case) or its number 0-3.
+// priority must be 1-3 and estimatedTime must not be negative.
+// deadline is ISO-8601: YYYY-MM-DD, optionally followed by THH:MM[:SS[.fraction]]
+// and Z or a +HH:MM / -HH:MM offset (UTC if none). An empty deadline leaves
+// the Task default. Blank lines are skipped; any other bad line is rejected.
+enum class ImportFormat : std::uint8_t {
+    Csv,
+    JsonLines
+};
+
+struct ImportOptions {
+    ImportFormat format = ImportFormat::Csv;
+    std::size_t chunkBytes = 1 << 20;  // Text parsed by one job; cut at a line end
+    std::size_t chunksPerWindow = 0;   // Chunks read and parsed per round; 0 = 4 per pool thread
+    // Register owners that do not exist yet, with 'defaultPassword'. Off by
+    // default, and with an empty password no user is created either: the
+    // tasks of unknown owners are then rejected.
+    bool createUsers = false;
+    std::string defaultPassword;       // Password given to users created by the import
+};
+
+struct ImportResult {
+    std::size_t imported = 0;
+    std::size_t rejected = 0;           // Malformed lines, plus tasks of unknown owners
+    std::size_t bytes = 0;              // Input consumed
+    std::size_t lines = 0;
+    std::size_t firstRejectedLine = 0;  // 1-based, 0 if no line was malformed
+};
+
+// Tasks parsed from one chunk of input, grouped by owner in first-seen order
+struct ParsedChunk {
+    std::vector<std::string> owners;
+    std::vector<std::vector<Task>> tasks;  // tasks[i] belong to owners[i], in input order
+    std::size_t lines = 0;
+    std::size_t rejected = 0;
+    std::size_t firstRejectedLine = 0;  // 1-based within the chunk, 0 if none
+
+    void clear();
+};
+
+// Streams task exports into UserManager users. Input is read a window at a
+// time; each window is cut into chunks at line ends, the chunks are parsed
+// in parallel on the pool, and the results are merged into users through
+// User::addTasks in input order while the next window is being parsed.
+// Fields are scanned in place; no iostreams are involved.
+//
+// The caller must not use 'users' from other threads during an import.
+// The pool should not be running other work: the importer waits for it to drain.
+class TaskImporter {
+private:
+    WorkStealingPool& pool;
+    ImportOptions options;
+
+    // Pull the next window of complete lines; empty when the input is exhausted
+    template <typename NextWindow>
+    ImportResult run(NextWindow nextWindow, UserManager& users);
+
+    void merge(ParsedChunk& chunk, UserManager& users, ImportResult& result);
+
+public:
+    TaskImporter(WorkStealingPool& workers, const ImportOptions& importOptions = ImportOptions())
+        : pool(workers), options(importOptions) {}
+
+    // Import a file; false if it cannot be read (tasks merged before a read
+    // error stay imported)
+    bool importFile(const std::string& path, UserManager& users, ImportResult& result);
+
+    // Import text already in memory
+    ImportResult importText(std::string_view text, UserManager& users);
+
+    // Parse complete lines into 'out'. 'atStart' allows a CSV header line.
+    static void parseChunk(std::string_view text, ImportFormat format, bool atStart, ParsedChunk& out);
+
+    // Parse a kind name (any case) or number as described above
+    static bool parseKind(std::string_view text, TaskKind& kind);
+
+    // Parse an ISO-8601 date or date-time as described above
+    static bool parseDeadline(std::string_view text, std::chrono::system_clock::time_point& deadline);
+};
+
+#endif
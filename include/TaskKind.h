@@ -0,0 +1,64 @@
+#ifndef TASK_KIND_H
+#define TASK_KIND_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Kind of work a task represents
+enum class TaskKind : std::uint8_t {
+    Ai,
+    Hpc,
+    Programming,
+    Devops
+};
+
+constexpr int TaskKindCount = 4;
+
+// Compile-time properties of each task kind
+template <TaskKind K>
+struct TaskKindTraits;
+
+template <>
+struct TaskKindTraits<TaskKind::Ai> {
+    static constexpr const char* label = "AI Task";
+};
+
+template <>
+struct TaskKindTraits<TaskKind::Hpc> {
+    static constexpr const char* label = "AI Task";  // As printed by HpcTask::displayTask
+};
+
+template <>
+struct TaskKindTraits<TaskKind::Programming> {
+    static constexpr const char* label = "AI Task";  // As printed by ProgrammingTask::displayTask
+};
+
+template <>
+struct TaskKindTraits<TaskKind::Devops> {
+    static constexpr const char* label = "Devops Task";
+};
+
+// Empty tag type carrying a kind as a compile-time constant
+template <TaskKind K>
+using TaskKindTag = std::integral_constant<TaskKind, K>;
+
+// Turn a runtime kind into a compile-time tag: calls f(TaskKindTag<K>{}) for the
+// matching K, so the body of f is instantiated (and inlined) once per kind.
+template <typename F>
+decltype(auto) visitKind(TaskKind kind, F&& f) {
+    switch (kind) {
+        case TaskKind::Ai: return f(TaskKindTag<TaskKind::Ai>{});
+        case TaskKind::Hpc: return f(TaskKindTag<TaskKind::Hpc>{});
+        case TaskKind::Programming: return f(TaskKindTag<TaskKind::Programming>{});
+        default: return f(TaskKindTag<TaskKind::Devops>{});
+    }
+}
+
+// Label printed in front of a task of the given kind
+inline const char* taskKindLabel(TaskKind kind) {
+    return visitKind(kind, [](auto tag) {
+        return TaskKindTraits<decltype(tag)::value>::label;
+    });
+}
+
+#endif
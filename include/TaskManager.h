@@ -3,21 +3,101 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
+#include <ostream>
 #include "BaseTask.h"
+#include "TaskStore.h"
+#include "MappedTaskStore.h"
+#include "PriorityIndex.h"
+#include "TaskArena.h"
+#include "TaskQuery.h"
+#include "TaskGraph.h"
+
+class WorkStealingPool;
 
 class TaskManager {
 private:
-    std::vector<std::unique_ptr<BaseTask>> tasks;
+    TaskStore store;            // Column storage for all tasks
+    std::vector<TaskId> order;  // Display order, rearranged by prioritizeTasks; may hold removed IDs
+    std::size_t removedInOrder = 0;  // Removed IDs still in 'order', dropped once they are half of it
+    std::shared_ptr<TaskArena> arena = std::make_shared<TaskArena>();  // Per-task index nodes
+    PriorityIndex priorityIndex{arena};  // Tasks kept in priority/deadline order
+    std::unique_ptr<MappedTaskStore> mapped;  // Set while in read-only mode
+    std::vector<std::function<void()>> payloads;  // Work run by run(), indexed by TaskId; may be empty
+    TaskGraph graph;  // Dependencies between tasks
 
 public:
-    void addTask(std::unique_ptr<BaseTask> task);
+    // The task object is copied into the store and then released
+    TaskId addTask(std::unique_ptr<BaseTask> task);
+    TaskId addTask(const Task& task);
+
+    // Add 'count' tasks in one go: capacity is reserved once and the indexes
+    // are filled in a single sorted pass. The tasks get consecutive IDs; the
+    // first is returned (TaskStore::npos if read-only or 'count' is 0).
+    TaskId addTasks(const Task* tasks, std::size_t count);
+    TaskId addTasks(const std::vector<Task>& tasks) { return addTasks(tasks.data(), tasks.size()); }
+
+    // Add a task whose work is 'payload'; run() executes it
+    TaskId addTask(const Task& task, std::function<void()> payload);
+
+    // Run the payload of every incomplete task on 'pool', highest priority
+    // first, and mark each task complete once its payload has returned.
+    // A task starts only after all its prerequisites completed; dependents
+    // are submitted as soon as their last prerequisite finishes.
+    // A payload that throws leaves its task (and its dependents) incomplete.
+    // Tasks without a payload are skipped. Returns how many tasks were completed.
+    std::size_t run(WorkStealingPool& pool);
+    std::size_t run();  // Uses a pool with one thread per core
+
     void displayTasks() const;
+    void displayTasks(std::ostream& out) const;
     void prioritizeTasks();
     
     // New function to display tasks based on priority
     void displayTasksByPriority() const;
+    void displayTasksByPriority(std::ostream& out) const;
 
     bool markTaskComplete(const std::string& taskName);
+
+    // Remove the first task added with the given name
+    bool removeTask(const std::string& taskName);
+
+    // Change the priority and deadline of the first task with the given name
+    bool updateTask(const std::string& taskName, int priority, std::chrono::system_clock::time_point deadline);
+
+    // Make 'task' wait for 'prerequisite'; fails if either is unknown or the
+    // edge would create a cycle
+    bool addDependency(TaskId task, TaskId prerequisite);
+
+    // Next task whose prerequisites are all complete, in the order they became runnable
+    bool popReadyTask(TaskId& id) { return graph.popReady(id); }
+    const TaskGraph& getGraph() const { return graph; }
+
+    // Tasks in priority order (high first), then deadline, then insertion order
+    const PriorityIndex& getPriorityIndex() const { return priorityIndex; }
+
+    // Read-only access to the underlying columns
+    const TaskStore& getStore() const { return store; }
+
+    // Slabs backing the per-task index nodes
+    const TaskArena& getArena() const { return *arena; }
+
+    // Write the tasks in the fixed-stride layout used by openReadOnly
+    bool saveReadOnly(const std::string& path) const;
+
+    // Query a file written by saveReadOnly in place, without loading it.
+    // While read-only, addTask returns TaskStore::npos and other mutations fail.
+    bool openReadOnly(const std::string& path);
+    bool isReadOnly() const { return mapped != nullptr; }
+
+    // Queries that work in both modes
+    std::size_t taskCount() const;
+    std::vector<TaskId> tasksWithPriority(int priority) const;
+    std::vector<TaskId> overdueTasks(std::chrono::system_clock::time_point now = std::chrono::system_clock::now()) const;
+
+    // The k best incomplete tasks to work on next, best first
+    std::vector<TaskHandle> nextTasks(std::size_t k, const TaskFilter& filter = TaskFilter(),
+                                      const TaskScoring& scoring = TaskScoring()) const;
 };
 
 #endif
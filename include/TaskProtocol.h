@@ -0,0 +1,110 @@
+#ifndef TASK_PROTOCOL_H
+#define TASK_PROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "BinaryIO.h"
+
+// Binary request/response protocol spoken by TaskServer and TaskClient.
+//
+// Every message is a frame: u32 bodyLength, then the body. Integers are
+// little-endian and strings are u32-length-prefixed, as in binio.
+//   Request body:  u32 requestId, u8 opcode, opcode fields
+//   Response body: u32 requestId, u8 status, result fields (only when status is Ok)
+// Responses on a connection come back in request order, so a client may send
+// many requests before reading any response (pipelining).
+//
+//   Register / Login    string username, string password  ->  nothing
+//   Logout              nothing                           ->  nothing
+//   AddTask             u8 kind, string name, i32 priority,
+//                       i32 estimatedTime, i64 deadline   ->  u32 taskId
+//                       (priority 1-3, estimatedTime in hours and not negative,
+//                       deadline in nanoseconds since the Unix epoch)
+//   MarkTaskComplete    string name                       ->  nothing
+//   ListTasks           u32 limit, u8 resume, then if resume is 1:
+//                       i32 priority, i64 deadline, u32 taskId
+//                                                         ->  u32 total, u8 more, u32 count, then
+//                       per task in priority order: u32 taskId, u8 kind, string name,
+//                       i32 priority, i32 estimatedTime, i64 deadline, u8 completed
+// Task operations apply to the user logged in on the connection.
+//
+// A ListTasks response holds at most 'limit' tasks (0 means no limit) and
+// stops early rather than exceed MaxFrameBytes; 'total' is the user's task
+// count and 'more' is 1 when tasks remain after the last one sent. A client
+// pages through a long list by resuming from the priority, deadline and ID
+// of the last task it received; the server seeks straight to that key, so
+// each page costs the same however deep into the list it starts. Tasks
+// added, updated or removed between pages may be missed or seen twice.
+namespace protocol {
+
+constexpr std::size_t HeaderBytes = 4;
+constexpr std::uint32_t MaxFrameBytes = 1u << 20;  // Larger frames close the connection
+
+enum class Opcode : std::uint8_t {
+    Register = 1,
+    Login = 2,
+    Logout = 3,
+    AddTask = 4,
+    MarkTaskComplete = 5,
+    ListTasks = 6
+};
+
+enum class Status : std::uint8_t {
+    Ok = 0,
+    BadRequest = 1,    // Unknown opcode or malformed fields
+    AuthFailed = 2,    // Wrong username or password
+    NotLoggedIn = 3,
+    AlreadyExists = 4, // Username taken
+    NotFound = 5,      // No such task
+    TooLarge = 6       // A single task does not fit in a response frame
+};
+
+// Reserve room for a frame header at the end of 'out'; returns its offset
+inline std::size_t beginFrame(std::string& out) {
+    std::size_t offset = out.size();
+    out.append(HeaderBytes, '\0');
+    return offset;
+}
+
+// Fill in the header reserved by beginFrame once the body is written
+inline void endFrame(std::string& out, std::size_t offset) {
+    std::uint32_t length = static_cast<std::uint32_t>(out.size() - offset - HeaderBytes);
+    if (!binio::HostIsLittleEndian) {
+        length = binio::byteSwap(length);
+    }
+    std::memcpy(&out[offset], &length, HeaderBytes);
+}
+
+enum class FrameState {
+    Complete,
+    Incomplete,
+    TooLarge
+};
+
+// Look for a whole frame at the start of [data, data + size). On Complete,
+// 'body' views the body and 'frameBytes' is the size including the header.
+inline FrameState nextFrame(const char* data, std::size_t size, std::string_view& body, std::size_t& frameBytes) {
+    if (size < HeaderBytes) {
+        return FrameState::Incomplete;
+    }
+    std::uint32_t length;
+    std::memcpy(&length, data, HeaderBytes);
+    if (!binio::HostIsLittleEndian) {
+        length = binio::byteSwap(length);
+    }
+    if (length > MaxFrameBytes) {
+        return FrameState::TooLarge;
+    }
+    if (size - HeaderBytes < length) {
+        return FrameState::Incomplete;
+    }
+    body = std::string_view(data + HeaderBytes, length);
+    frameBytes = HeaderBytes + length;
+    return FrameState::Complete;
+}
+
+}
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef TASK_QUERY_H
+#define TASK_QUERY_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "PriorityIndex.h"
+#include "TaskKind.h"
+#include "TaskStore.h"
+
+// Restricts which open tasks nextTasks may return. Every field defaults to
+// "no restriction"; the fields are checked before the optional predicate.
+struct TaskFilter {
+    std::uint8_t kinds = 0xFF;                  // Bit (1 << kind) per allowed TaskKind
+    int minPriority = 0;
+    int maxEstimatedTime = 0x7FFFFFFF;
+    std::chrono::system_clock::time_point dueBefore = std::chrono::system_clock::time_point::max();
+    std::function<bool(TaskId)> predicate;      // Extra test, if set
+
+    TaskFilter& onlyKind(TaskKind kind) {
+        kinds = static_cast<std::uint8_t>(1u << static_cast<unsigned>(kind));
+        return *this;
+    }
+
+    template <typename Store>
+    bool accepts(const Store& store, TaskId id) const {
+        return (kinds >> static_cast<unsigned>(store.kind(id)) & 1u) != 0
+            && store.priority(id) >= minPriority
+            && store.estimatedTime(id) <= maxEstimatedTime
+            && store.deadline(id) < dueBefore
+            && (!predicate || predicate(id));
+    }
+};
+
+// Score used to rank open tasks; higher scores come first and ties go to the
+// earlier deadline, then the older task:
+//   priorityWeight * priority
+//   + urgencyWeight / (1 + hours left until the deadline, 0 once overdue)
+//   + effortWeight * estimatedTime (negative to favour quick tasks)
+// The defaults rank by priority and then deadline, which nextTasks answers
+// from the priority index without scoring every task.
+struct TaskScoring {
+    double priorityWeight = 1.0;
+    double urgencyWeight = 0.0;
+    double effortWeight = 0.0;
+    std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    bool ranksLikeIndex() const {
+        return priorityWeight > 0.0 && urgencyWeight == 0.0 && effortWeight == 0.0;
+    }
+
+    template <typename Store>
+    double score(const Store& store, TaskId id) const {
+        double hoursLeft = std::chrono::duration<double, std::ratio<3600>>(store.deadline(id) - now).count();
+        return priorityWeight * store.priority(id)
+            + urgencyWeight / (1.0 + std::max(0.0, hoursLeft))
+            + effortWeight * store.estimatedTime(id);
+    }
+};
+
+// A ranked result: the task's ID plus the score it was ranked by
+struct TaskHandle {
+    TaskId id;
+    double score;
+};
+
+namespace query {
+
+// The k best open tasks accepted by 'filter', best first. 'index' may be null
+// (e.g. for a mapped store); then every task is scored with a bounded heap,
+// O(n log k). With an index and default-like scoring the walk stops after k
+// accepted tasks.
+template <typename Store>
+std::vector<TaskHandle> nextTasks(const Store& store, const PriorityIndex* index, std::size_t k,
+                                  const TaskFilter& filter, const TaskScoring& scoring) {
+    std::vector<TaskHandle> best;
+    if (k == 0) {
+        return best;
+    }
+    if (index && scoring.ranksLikeIndex()) {
+        index->forEachOpen([&](TaskId id) {
+            if (filter.accepts(store, id)) {
+                best.push_back(TaskHandle{id, scoring.score(store, id)});
+            }
+            return best.size() < k;
+        });
+        return best;
+    }
+
+    // Heap ordered so the worst of the current best k sits on top
+    auto better = [&](const TaskHandle& a, const TaskHandle& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        if (store.deadline(a.id) != store.deadline(b.id)) {
+            return store.deadline(a.id) < store.deadline(b.id);
+        }
+        return a.id < b.id;
+    };
+    best.reserve(k);
+    store.forEach([&](TaskId id) {
+        if (store.isCompleted(id) || !filter.accepts(store, id)) {
+            return;
+        }
+        TaskHandle candidate{id, scoring.score(store, id)};
+        if (best.size() < k) {
+            best.push_back(candidate);
+            std::push_heap(best.begin(), best.end(), better);
+        } else if (better(candidate, best.front())) {
+            std::pop_heap(best.begin(), best.end(), better);
+            best.back() = candidate;
+            std::push_heap(best.begin(), best.end(), better);
+        }
+    });
+    std::sort_heap(best.begin(), best.end(), better);
+    return best;
+}
+
+}
+
+#endif
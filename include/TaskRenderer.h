@@ -0,0 +1,66 @@
+#ifndef TASK_RENDERER_H
+#define TASK_RENDERER_H
+
+#include <ctime>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "TaskStore.h"
+
+// Formats task listings into a reusable in-memory buffer so a whole report
+// is written with a single write and flush instead of one flush per line.
+class TaskRenderer {
+public:
+    // Capacity kept across reports; a buffer grown past this by one large
+    // report is released when it is flushed or cleared
+    static constexpr std::size_t RetainedCapacity = 1u << 20;
+
+private:
+    // Small direct-mapped cache of formatted deadlines; listings tend to
+    // repeat the same few deadlines and ctime_r is comparatively slow.
+    static constexpr std::size_t DeadlineCacheSize = 4096; // Must match the hash shift in formatDeadline
+    struct CachedDeadline {
+        std::time_t time = 0;
+        bool valid = false;
+        char text[24];
+    };
+
+    std::string buffer;
+    CachedDeadline deadlineCache[DeadlineCacheSize];
+
+    const char* formatDeadline(std::time_t time);
+
+    void reset();
+
+public:
+    void append(std::string_view text) { buffer.append(text); }
+    void appendInt(long long value);
+
+    // Append one task line, formatted like BaseTask::displayTask. Works with
+    // any store exposing the TaskStore accessors (TaskStore, MappedTaskStore).
+    template <typename Store>
+    void appendTask(const Store& store, TaskId id) {
+        buffer.append(taskKindLabel(store.kind(id)));
+        buffer.append(": ");
+        buffer.append(store.name(id));
+        buffer.append(" | Priority: ");
+        appendInt(store.priority(id));
+        buffer.append(" | Deadline: ");
+        buffer.append(formatDeadline(std::chrono::system_clock::to_time_t(store.deadline(id))), 24);
+        buffer.append(" | Estimated Time: ");
+        appendInt(store.estimatedTime(id));
+        buffer.append(" hours | Completed: ");
+        buffer.append(store.isCompleted(id) ? "Yes\n" : "No\n");
+    }
+
+    // Write everything buffered so far, flush once and reset the buffer
+    void flushTo(std::ostream& out);
+
+    const std::string& str() const { return buffer; }
+    void clear() { reset(); }
+
+    // Per-thread renderer whose buffer capacity is reused across reports
+    static TaskRenderer& local();
+};
+
+#endif
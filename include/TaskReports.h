@@ -0,0 +1,78 @@
+#ifndef TASK_REPORTS_H
+#define TASK_REPORTS_H
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include "TaskRenderer.h"
+#include "TaskStore.h"
+
+// Report layouts shared by every task container. 'Store' is any type with
+// the TaskStore read interface (TaskStore, MappedTaskStore, TaskSnapshot).
+namespace reports {
+
+// Every live task in ID order
+template <typename Store>
+void renderAll(const Store& store, TaskRenderer& renderer) {
+    store.forEach([&](TaskId id) {
+        renderer.appendTask(store, id);
+    });
+}
+
+// Tasks of several stores (e.g. the shards of one container) grouped
+// High -> Low priority; within a level tasks stay in store order, then ID order
+template <typename Store>
+void renderByPriority(const std::vector<const Store*>& stores, TaskRenderer& renderer) {
+    // Bucket the tasks in one sweep
+    std::vector<std::pair<const Store*, TaskId>> buckets[3];
+    for (const Store* store : stores) {
+        store->forEach([&](TaskId id) {
+            int level = store->priority(id);
+            if (level >= 1 && level <= 3) {
+                buckets[level - 1].emplace_back(store, id);
+            }
+        });
+    }
+
+    const char* headers[] = {
+        "\nLow Priority Tasks (Priority 1):\n",
+        "\nMedium Priority Tasks (Priority 2):\n",
+        "\nHigh Priority Tasks (Priority 3):\n",
+    };
+    for (int level = 3; level >= 1; --level) {
+        renderer.append(headers[level - 1]);
+        for (const auto& entry : buckets[level - 1]) {
+            renderer.appendTask(*entry.first, entry.second);
+        }
+    }
+}
+
+// Tasks grouped High -> Low priority; within a level tasks stay in ID order
+template <typename Store>
+void renderByPriority(const Store& store, TaskRenderer& renderer) {
+    renderByPriority(std::vector<const Store*>{&store}, renderer);
+}
+
+// Tasks sorted by priority (high first) and then deadline (earliest first)
+template <typename Store>
+void renderSorted(const Store& store, TaskRenderer& renderer) {
+    std::vector<TaskId> sortedTasks;
+    sortedTasks.reserve(store.size());
+    store.forEach([&](TaskId id) {
+        sortedTasks.push_back(id);
+    });
+    std::sort(sortedTasks.begin(), sortedTasks.end(), [&](TaskId a, TaskId b) {
+        if (store.priority(a) == store.priority(b)) {
+            return store.deadline(a) < store.deadline(b); // Earlier deadline first
+        }
+        return store.priority(a) > store.priority(b); // Higher priority first
+    });
+    for (TaskId id : sortedTasks) {
+        renderer.appendTask(store, id);
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef TASK_SERVER_H
+#define TASK_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "SessionTable.h"
+#include "TaskProtocol.h"
+
+class UserManager;
+
+// Serves a UserManager over a Unix domain socket and/or localhost TCP using
+// the protocol in TaskProtocol.h.
+//
+// One thread runs a non-blocking, level-triggered epoll loop. Each wakeup
+// reads everything the ready connections have sent, executes every complete
+// request in order, syncs the mutation log once for the whole round (if the
+// UserManager has storage open) and only then writes the queued responses,
+// one write per connection. Pipelined requests therefore share both the
+// fsync and the send. A connection whose unsent responses pile up past
+// MaxPendingOutput stops being read until the client catches up.
+//
+// Each connection logs in on its own UserManager session, closed when the
+// connection goes away; UserManager's current user is not used. Other
+// threads may use the same UserManager through sessions of their own.
+class TaskServer {
+public:
+    static constexpr std::size_t MaxPendingOutput = 4u << 20;
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::string input;          // Bytes received, not yet parsed
+        std::size_t inputOffset = 0;
+        std::string output;         // Encoded responses not yet sent
+        std::size_t outputOffset = 0;
+        SessionToken session = SessionTable::NoSession; // Login, if any
+        std::uint32_t events = 0;   // epoll interest currently registered
+        bool readPaused = false;    // Too much unsent output; stop reading
+        bool peerClosed = false;    // Client shut down its side; close once output is sent
+        bool dirty = false;         // Queued on this round's flush list
+    };
+
+    UserManager& users;
+    int epollFd = -1;
+    int wakeFd = -1;
+    int unixFd = -1;
+    int tcpFd = -1;
+    int tcpPort = 0;
+    std::string unixPath;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::atomic<bool> stopping{false};
+    std::atomic<std::uint64_t> requests{0};
+    bool mutated = false;  // A request this round changed state, so the log needs a sync
+
+    bool watch(int fd);
+    void accept(int listenFd);
+    void close(int fd);
+    bool readFrom(Connection& connection);
+    bool processInput(Connection& connection);
+    bool flush(Connection& connection);
+    void updateInterest(Connection& connection);
+    void handle(Connection& connection, std::string_view request);
+    protocol::Status execute(Connection& connection, protocol::Opcode opcode, binio::Reader& reader,
+                             std::string& out);
+
+public:
+    explicit TaskServer(UserManager& userManager);
+    TaskServer(const TaskServer&) = delete;
+    TaskServer& operator=(const TaskServer&) = delete;
+    ~TaskServer();
+
+    // Listen on a Unix domain socket, replacing a stale socket file; fails
+    // if 'path' names anything other than a socket
+    bool listenUnix(const std::string& path);
+
+    // Listen on 127.0.0.1; port 0 picks a free port, see port()
+    bool listenTcp(int port);
+    int port() const { return tcpPort; }
+
+    // Serve until stop() is called. Returns false if nothing is listening.
+    bool run();
+
+    // Make run() return; safe to call from any thread or a signal handler
+    void stop();
+
+    std::uint64_t requestCount() const { return requests.load(std::memory_order_relaxed); }
+};
+
+#endif
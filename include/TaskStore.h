@@ -0,0 +1,116 @@
+#ifndef TASK_STORE_H
+#define TASK_STORE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BaseTask.h"
+#include "StringInterner.h"
+#include "Task.h"
+#include "TaskKind.h"
+
+// Stable handle for a task in a TaskStore. IDs are never reused.
+using TaskId = std::uint32_t;
+
+// Column-oriented task storage. Every task attribute lives in its own packed
+// array indexed by TaskId, so filters and sorts over a single attribute sweep
+// contiguous memory instead of chasing pointers to individual task objects.
+class TaskStore {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    static constexpr TaskId npos = static_cast<TaskId>(-1);
+
+private:
+    // Bits stored in the 'flags' column
+    static constexpr std::uint8_t CompletedFlag = 1;
+    static constexpr std::uint8_t RemovedFlag = 2;
+
+    StringInterner names;               // Interned task names
+    std::vector<Symbol> nameColumn;     // Name symbol per task
+    std::vector<int> priorities;        // Task priority (1 = Low, 3 = High)
+    std::vector<TimePoint> deadlines;   // Task deadline
+    std::vector<int> estimatedTimes;    // Estimated time in hours
+    std::vector<std::uint8_t> flags;    // Completed / removed bits
+    std::vector<TaskKind> kinds;        // Task kind
+    // Live tasks sharing a name form a chain in ID order, so removing one
+    // costs at most a walk over that name's duplicates, never the store
+    std::vector<TaskId> nextSameName;   // Next live task with the same name, or npos
+    std::vector<TaskId> firstByName;    // Name symbol -> first live task with that name
+    std::vector<TaskId> lastByName;     // Name symbol -> last live task with that name
+    std::size_t liveCount = 0;
+
+    // Recompute the name chains and liveCount from the columns
+    void rebuildNameIndex();
+
+    friend class SnapshotCodec;
+
+public:
+    // Make room for tasks with IDs below 'count'. Grows at least geometrically,
+    // so a run of small batch reserves stays amortized linear.
+    void reserve(std::size_t count);
+
+    // Append a task and return its ID
+    TaskId add(TaskKind kind, std::string_view name, int priority, int estimatedTime,
+               TimePoint deadline = TimePoint(), bool completed = false);
+
+    // Append a value-type task
+    TaskId add(const Task& task);
+
+    // Append a copy of an existing task object
+    TaskId add(const BaseTask& task);
+
+    // Materialize a task as a value
+    Task get(TaskId id) const;
+
+    // Remove a task; its ID stays reserved
+    bool remove(TaskId id);
+
+    // First live task added under 'name', or npos
+    TaskId findByName(std::string_view name) const;
+
+    // Number of IDs handed out, including removed tasks
+    std::size_t capacity() const { return kinds.size(); }
+
+    // Number of live tasks
+    std::size_t size() const { return liveCount; }
+
+    bool contains(TaskId id) const { return id < flags.size() && !(flags[id] & RemovedFlag); }
+
+    // Attribute accessors
+    std::string_view name(TaskId id) const { return names.view(nameColumn[id]); }
+    Symbol nameSymbol(TaskId id) const { return nameColumn[id]; }
+    int priority(TaskId id) const { return priorities[id]; }
+    TimePoint deadline(TaskId id) const { return deadlines[id]; }
+    int estimatedTime(TaskId id) const { return estimatedTimes[id]; }
+    bool isCompleted(TaskId id) const { return flags[id] & CompletedFlag; }
+    TaskKind kind(TaskId id) const { return kinds[id]; }
+
+    void markComplete(TaskId id) { flags[id] |= CompletedFlag; }
+    void setDeadline(TaskId id, TimePoint deadline) { deadlines[id] = deadline; }
+    void setPriority(TaskId id, int priority) { priorities[id] = priority; }
+
+    // Raw columns for tight sweeps; entries of removed tasks must be skipped via contains()
+    const std::vector<int>& priorityColumn() const { return priorities; }
+    const std::vector<TimePoint>& deadlineColumn() const { return deadlines; }
+
+    // Call f(id) for every live task in ID order
+    template <typename F>
+    void forEach(F f) const {
+        for (TaskId id = 0; id < flags.size(); ++id) {
+            if (!(flags[id] & RemovedFlag)) {
+                f(id);
+            }
+        }
+    }
+
+    // Print a task in the same format as BaseTask::displayTask
+    void displayTask(TaskId id) const;
+
+    // Convert a task's deadline to a human-readable string
+    std::string deadlineToString(TaskId id) const;
+};
+
+#endif
@@ -2,110 +2,317 @@
 #define USER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <algorithm> // For sorting
 #include <iostream>
 #include "BaseTask.h"
+#include "SymbolTable.h"
+#include "TaskStore.h"
+#include "TaskRenderer.h"
+#include "TaskReports.h"
+#include "MutationLog.h"
+#include "DeadlineIndex.h"
+#include "TaskArena.h"
+#include "DeadlineWatcher.h"
+#include "PriorityIndex.h"
+#include "TaskQuery.h"
+#include "Scheduler.h"
+#include "WeeklyPlanner.h"
+#include "OpStats.h"
+#include "PasswordHash.h"
 
 class User {
 private:
-    std::string username; // Username of the user
-    std::string password; // Password of the user
-    std::vector<std::unique_ptr<BaseTask>> tasks;  // Tasks for this user
+    std::string_view username; // Username of the user, held in SymbolTable::global() for the user's lifetime
+    Symbol usernameSymbol; // Equal usernames have equal symbols
+    PasswordHash password; // Salted hash of the user's password
+    TaskStore tasks;  // Tasks for this user
+    MutationLog* log = nullptr;  // Receives every mutation when persistence is enabled
+    std::shared_ptr<TaskArena> arena = std::make_shared<TaskArena>();  // Per-task index nodes
+    DeadlineIndex deadlineIndex{arena};  // Tasks ordered by deadline
+    PriorityIndex priorityIndex{arena};  // Tasks ordered by priority, then deadline
+    std::unique_ptr<DeadlineWatcher> watcher;  // Fires when tasks become overdue, if enabled
+    std::unique_ptr<Scheduler> scheduler;  // Execution plan for open tasks, if enabled
+    mutable std::mutex mutex;  // Held by UserManager::withSession around each call
+
+    friend class SnapshotCodec;
+
+    // Bring the indexes up to date after a task was appended to the store
+    TaskId taskAdded(TaskId id) {
+        deadlineIndex.insert(id, tasks.deadline(id));
+        priorityIndex.insert(PriorityIndex::keyOf(tasks, id), tasks.isCompleted(id));
+        if (watcher && !tasks.isCompleted(id)) {
+            watcher->schedule(id, tasks.deadline(id));
+        }
+        if (scheduler && !tasks.isCompleted(id)) {
+            scheduler->add(id, tasks.priority(id), tasks.estimatedTime(id), tasks.deadline(id));
+        }
+        if (log) {
+            log->appendAddTask(username, tasks, id);
+        }
+        return id;
+    }
+
+    // Recompute the indexes after the store was filled directly
+    void rebuildIndexes() {
+        deadlineIndex.rebuild(tasks);
+        priorityIndex.rebuild(tasks);
+        if (scheduler) {
+            scheduler->rebuild(tasks);
+        }
+    }
 
 public:
     // Constructor
-    User(const std::string& uname, const std::string& pwd)
-        : username(uname), password(pwd) {}
+    User(std::string_view uname, const std::string& pwd)
+        : User(uname, PasswordHash::create(pwd)) {}
+
+    // A user whose password was hashed earlier (snapshots, the mutation log)
+    User(std::string_view uname, const PasswordHash& hash)
+        : password(hash) {
+        InternedName interned = SymbolTable::global().intern(uname);
+        username = interned.text;
+        usernameSymbol = interned.symbol;
+    }
+
+    ~User() {
+        SymbolTable::global().release(usernameSymbol);
+    }
 
     // Accessors
-    const std::string& getUsername() const { return username; }
-    bool checkPassword(const std::string& pwd) const { return password == pwd; }
+    std::string_view getUsername() const { return username; }
+    Symbol getUsernameSymbol() const { return usernameSymbol; }
+    bool checkPassword(const std::string& pwd) const { return password.matches(pwd); }
+    const PasswordHash& getPasswordHash() const { return password; }
+    const TaskStore& getTasks() const { return tasks; }
+    const DeadlineIndex& getDeadlineIndex() const { return deadlineIndex; }
+    const PriorityIndex& getPriorityIndex() const { return priorityIndex; }
+    const TaskArena& getArena() const { return *arena; }
+
+    void attachLog(MutationLog* mutationLog) { log = mutationLog; }
+
+    // User itself is not thread-safe; threads sharing a User serialize on this
+    std::unique_lock<std::mutex> lock() const { return std::unique_lock<std::mutex>(mutex); }
 
     // Add a task to the user's task list
-    void addTask(std::unique_ptr<BaseTask> task) {
-        tasks.push_back(std::move(task));
+    TaskId addTask(std::unique_ptr<BaseTask> task) {
+        OpTimer timer(Operation::AddTask);
+        return taskAdded(tasks.add(*task));
+    }
+
+    TaskId addTask(const Task& task) {
+        OpTimer timer(Operation::AddTask);
+        return taskAdded(tasks.add(task));
+    }
+
+    // Add 'count' tasks in one go: capacity is reserved once and each index
+    // is filled in a single sorted pass. The tasks get consecutive IDs; the
+    // first is returned (TaskStore::npos if 'count' is 0).
+    TaskId addTasks(const Task* batch, std::size_t count) {
+        OpTimer timer(Operation::AddTask);
+        if (count == 0) {
+            return TaskStore::npos;
+        }
+        TaskId first = static_cast<TaskId>(tasks.capacity());
+        TaskId last = static_cast<TaskId>(first + count);
+        tasks.reserve(last);
+        for (std::size_t i = 0; i < count; ++i) {
+            tasks.add(batch[i]);
+        }
+        deadlineIndex.insertBatch(tasks, first, last);
+        priorityIndex.insertBatch(tasks, first, last);
+        for (TaskId id = first; id < last; ++id) {
+            if (watcher && !tasks.isCompleted(id)) {
+                watcher->schedule(id, tasks.deadline(id));
+            }
+            if (scheduler && !tasks.isCompleted(id)) {
+                scheduler->add(id, tasks.priority(id), tasks.estimatedTime(id), tasks.deadline(id));
+            }
+        }
+        if (log) {
+            log->appendAddTasks(username, tasks, first, last);
+        }
+        return first;
+    }
+
+    TaskId addTasks(const std::vector<Task>& batch) {
+        return addTasks(batch.data(), batch.size());
     }
 
+    // Call onOverdue(id) from a background thread as soon as each incomplete
+    // task passes its deadline. Completing or removing a task cancels it.
+    // The callback must synchronize any access to this user itself.
+    void watchDeadlines(std::function<void(TaskId)> onOverdue) {
+        watcher = std::make_unique<DeadlineWatcher>([onOverdue](std::uint64_t key) {
+            onOverdue(static_cast<TaskId>(key));
+        });
+        tasks.forEach([this](TaskId id) {
+            if (!tasks.isCompleted(id)) {
+                watcher->schedule(id, tasks.deadline(id));
+            }
+        });
+    }
+
+    void stopWatchingDeadlines() {
+        watcher.reset();
+    }
+
+    // Keep an execution plan of the open tasks. It is updated incrementally
+    // as tasks are added, completed, updated and removed.
+    Scheduler& enableScheduling(const ScheduleOptions& options = ScheduleOptions()) {
+        scheduler = std::make_unique<Scheduler>(options);
+        scheduler->rebuild(tasks);
+        return *scheduler;
+    }
+
+    // Null unless enableScheduling was called
+    Scheduler* getScheduler() { return scheduler.get(); }
+
     // Display all tasks
     void displayTasks() const {
-        for (const auto& task : tasks) {
-            task->displayTask();
-        }
+        OpTimer timer(Operation::ListTasks);
+        TaskRenderer& renderer = TaskRenderer::local();
+        reports::renderAll(tasks, renderer);
+        renderer.flushTo(std::cout);
     }
 
     // Display tasks with deadlines and group them
     void displayTasksWithDeadlines() const {
+        OpTimer timer(Operation::ListTasks);
+        TaskRenderer& renderer = TaskRenderer::local();
+        renderTasksWithDeadlines(renderer);
+        renderer.flushTo(std::cout);
+    }
+
+    // Append the deadline report to 'renderer': overdue tasks, tasks due in
+    // the next 24 hours, then every task by priority
+    void renderTasksWithDeadlines(TaskRenderer& renderer) const {
         auto now = std::chrono::system_clock::now();
         auto nearDeadline = now + std::chrono::hours(24); // Tasks due in the next 24 hours
 
-        std::cout << "\nOverdue Tasks:\n";
-        for (const auto& task : tasks) {
-            if (task->isOverdue()) {
-                task->displayTask();
-            }
-        }
+        // Both groups come straight off the deadline index, earliest first
+        renderer.append("\nOverdue Tasks:\n");
+        deadlineIndex.forEachOverdue(now, [&](TaskId id) {
+            renderer.appendTask(tasks, id);
+        });
+        renderer.append("\nTasks Due Soon (Next 24 Hours):\n");
+        deadlineIndex.forEachDueBetween(now, nearDeadline, [&](TaskId id) {
+            renderer.appendTask(tasks, id);
+        });
+        renderer.append("\nOther Tasks (Sorted by Priority):\n");
+        priorityIndex.forEachSorted([&](TaskId id) {
+            renderer.appendTask(tasks, id);
+        });
+    }
 
-        std::cout << "\nTasks Due Soon (Next 24 Hours):\n";
-        for (const auto& task : tasks) {
-            if (!task->isOverdue() && task->getDeadline() <= nearDeadline) {
-                task->displayTask();
-            }
+    // Mark a task as complete by name
+    bool markTaskComplete(const std::string& taskName) {
+        OpTimer timer(Operation::CompleteTask);
+        TaskId id = tasks.findByName(taskName);
+        if (id == TaskStore::npos) {
+            return false;
+        }
+        priorityIndex.markComplete(PriorityIndex::keyOf(tasks, id));
+        tasks.markComplete(id);
+        if (watcher) {
+            watcher->cancel(id);
+        }
+        if (scheduler) {
+            scheduler->remove(id);
         }
+        if (log) {
+            log->appendCompleteTask(username, taskName);
+        }
+        return true;
+    }
 
-        std::cout << "\nOther Tasks (Sorted by Priority):\n";
-        displaySortedTasks();
+    // Remove a task by name
+    bool removeTask(const std::string& taskName) {
+        TaskId id = tasks.findByName(taskName);
+        if (!tasks.contains(id)) {
+            return false;
+        }
+        priorityIndex.erase(PriorityIndex::keyOf(tasks, id), tasks.isCompleted(id));
+        tasks.remove(id);
+        deadlineIndex.erase(id, tasks.deadline(id));
+        if (watcher) {
+            watcher->cancel(id);
+        }
+        if (scheduler) {
+            scheduler->remove(id);
+        }
+        if (log) {
+            log->appendRemoveTask(username, taskName);
+        }
+        return true;
     }
 
-    // Mark a task as complete by name
-    bool markTaskComplete(const std::string& taskName) {
-        for (auto& task : tasks) {
-            if (task->getName() == taskName) {
-                task->markAsComplete();
-                return true;
-            }
+    // Change a task's priority and deadline, keeping every index in order
+    bool updateTask(const std::string& taskName, int priority, std::chrono::system_clock::time_point deadline) {
+        TaskId id = tasks.findByName(taskName);
+        if (id == TaskStore::npos) {
+            return false;
+        }
+        PriorityIndex::Key before = PriorityIndex::keyOf(tasks, id);
+        deadlineIndex.erase(id, tasks.deadline(id));
+        tasks.setPriority(id, priority);
+        tasks.setDeadline(id, deadline);
+        deadlineIndex.insert(id, deadline);
+        priorityIndex.update(before, PriorityIndex::keyOf(tasks, id), tasks.isCompleted(id));
+        if (watcher && !tasks.isCompleted(id)) {
+            watcher->schedule(id, deadline);  // Supersedes the old deadline
+        }
+        if (scheduler && !tasks.isCompleted(id)) {
+            scheduler->add(id, priority, tasks.estimatedTime(id), deadline);
         }
-        return false;
+        if (log) {
+            log->appendUpdateTask(username, tasks, id);
+        }
+        return true;
+    }
+
+    // The k best incomplete tasks to work on next, best first
+    std::vector<TaskHandle> nextTasks(std::size_t k, const TaskFilter& filter = TaskFilter(),
+                                      const TaskScoring& scoring = TaskScoring()) const {
+        return query::nextTasks(tasks, &priorityIndex, k, filter, scoring);
+    }
+
+    // Pack the open tasks into working days; see WeeklyPlanner
+    WeeklyPlan planWeeks(const PlannerOptions& options = PlannerOptions()) const {
+        return WeeklyPlanner(options).plan(tasks);
     }
 
     // Notify user about overdue tasks
     void notifyOverdueTasks() const {
         bool hasOverdueTasks = false;
+        auto now = std::chrono::system_clock::now();
+        TaskRenderer& renderer = TaskRenderer::local();
 
-        for (const auto& task : tasks) {
-            if (task->isOverdue()) {
-                if (!hasOverdueTasks) {
-                    std::cout << "\nYou have overdue tasks:\n";
-                    hasOverdueTasks = true;
-                }
-                task->displayTask();
+        deadlineIndex.forEachOverdue(now, [&](TaskId id) {
+            if (!hasOverdueTasks) {
+                renderer.append("\nYou have overdue tasks:\n");
+                hasOverdueTasks = true;
             }
-        }
+            renderer.appendTask(tasks, id);
+        });
 
         if (!hasOverdueTasks) {
-            std::cout << "You have no overdue tasks.\n";
+            renderer.append("You have no overdue tasks.\n");
         }
+        renderer.flushTo(std::cout);
     }
 
-    // Helper to sort tasks by priority and deadline
+    // Display tasks by priority and deadline, read straight off the index
     void displaySortedTasks() const {
-        std::vector<BaseTask*> sortedTasks;
-        for (const auto& task : tasks) {
-            sortedTasks.push_back(task.get());
-        }
-
-        // Sort by priority and then by deadline
-        std::sort(sortedTasks.begin(), sortedTasks.end(), [](BaseTask* a, BaseTask* b) {
-            if (a->getPriority() == b->getPriority()) {
-                return a->getDeadline() < b->getDeadline(); // Earlier deadline first
-            }
-            return a->getPriority() > b->getPriority(); // Higher priority first
+        OpTimer timer(Operation::ListTasks);
+        TaskRenderer& renderer = TaskRenderer::local();
+        priorityIndex.forEachSorted([&](TaskId id) {
+            renderer.appendTask(tasks, id);
         });
-
-        for (const auto& task : sortedTasks) {
-            task->displayTask();
-        }
+        renderer.flushTo(std::cout);
     }
 };
 
@@ -1,29 +1,142 @@
 #ifndef USER_MANAGER_H
 #define USER_MANAGER_H
 
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 #include "User.h"
+#include "SymbolTable.h"
+#include "BinaryIO.h"
+#include "Snapshot.h"
+#include "MutationLog.h"
+#include "OpStats.h"
+#include "SessionTable.h"
 
+// Registered users, plus two ways of acting on their behalf:
+//
+// - One "current user" (loginUser / getCurrentUser), for the single-user
+//   front ends. It is not thread-safe.
+// - Any number of sessions (openSession / withSession), which may be used
+//   from many threads at once. The user map is read-mostly and sits behind
+//   a shared_mutex; each call made through a session holds only that user's
+//   own lock, so sessions of different users never contend.
+//
+// Anything else that changes a User while sessions may be open (imports,
+// batch scripts) goes through withUser, which takes the same lock.
+//
+// Registration, sessions and checkpoint() may run concurrently. Opening
+// storage or loading a snapshot must not overlap with any other call.
 class UserManager {
 private:
-    std::unordered_map<std::string, std::shared_ptr<User>> users;  // Maps usernames to User objects
+    mutable std::shared_mutex usersMutex;  // Guards the map itself, not the Users in it
+    std::unordered_map<Symbol, std::shared_ptr<User>> users;  // Maps username symbols to User objects
     std::shared_ptr<User> currentUser;  // Currently logged-in user
+    SessionTable sessions;
+    std::unique_ptr<MutationLog> log;  // Write-ahead log, when opened with openStorage
+    std::string snapshotPath;  // Snapshot written by checkpoint()
+    std::uint64_t snapshotSequence = 0;  // Last log record covered by the loaded snapshot
+    std::atomic<bool> checkpointDue{false};  // Compaction was requested while a lock was held
+
+    // Number of user locks (and the exclusive map lock) this thread holds.
+    // A compaction requested by the log while it is non-zero cannot lock
+    // every user, so it is deferred until the lock is released.
+    static inline thread_local int heldLocks = 0;
+
+    friend class SnapshotCodec;
+
+    struct HeldLock {
+        HeldLock() { ++heldLocks; }
+        ~HeldLock() { --heldLocks; }
+    };
+
+    void requestCheckpoint() {
+        if (heldLocks == 0) {
+            checkpoint();
+        } else {
+            checkpointDue.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    void runDeferredCheckpoint() {
+        if (heldLocks == 0 && checkpointDue.load(std::memory_order_relaxed) && checkpointDue.exchange(false)) {
+            checkpoint();
+        }
+    }
+
+    // Every user's lock, for a consistent view of all tasks; the caller
+    // holds usersMutex
+    std::vector<std::unique_lock<std::mutex>> lockAllUsers() const {
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(users.size());
+        for (const auto& entry : users) {
+            locks.push_back(entry.second->lock());
+        }
+        return locks;
+    }
+
+    void attachLogToUsers() {
+        for (auto& entry : users) {
+            entry.second->attachLog(log.get());
+        }
+    }
+
+    // User registered under 'username', or end() if none. A name that was
+    // never interned cannot belong to a user, so no string compare is needed.
+    // The caller holds usersMutex.
+    auto lookup(std::string_view username) const {
+        Symbol symbol = SymbolTable::global().find(username);
+        return symbol == StringInterner::npos ? users.end() : users.find(symbol);
+    }
 
 public:
-    bool registerUser(const std::string& username, const std::string& password) {
-        if (users.find(username) != users.end()) {
-            return false;  // User already exists
+    UserManager() = default;
+    UserManager(const UserManager&) = delete;
+    UserManager& operator=(const UserManager&) = delete;
+
+    // The log's final sync may ask for a compaction, which needs the rest
+    // of the manager, so it happens before any member is destroyed
+    ~UserManager() {
+        if (log) {
+            log->sync();
+            log->setCompactionHandler(nullptr);
         }
-        users[username] = std::make_shared<User>(username, password);
+    }
+
+    bool registerUser(std::string_view username, const std::string& password) {
+        return registerUser(username, PasswordHash::create(password));
+    }
+
+    // Register with a password hashed earlier, as stored in the mutation log
+    bool registerUser(std::string_view username, const PasswordHash& password) {
+        OpTimer timer(Operation::RegisterUser);
+        {
+            std::unique_lock<std::shared_mutex> lock(usersMutex);
+            HeldLock held;
+            if (lookup(username) != users.end()) {
+                return false;  // User already exists
+            }
+            auto user = std::make_shared<User>(username, password);
+            if (log) {
+                // Logged before the user becomes visible, so no task record can precede it
+                log->appendRegisterUser(username, password);
+                user->attachLog(log.get());
+            }
+            users[user->getUsernameSymbol()] = std::move(user);
+        }
+        runDeferredCheckpoint();
         return true;
     }
 
-    bool loginUser(const std::string& username, const std::string& password) {
-        auto it = users.find(username);
-        if (it != users.end() && it->second->checkPassword(password)) {
-            currentUser = it->second;
+    bool loginUser(std::string_view username, const std::string& password) {
+        OpTimer timer(Operation::Login);
+        std::shared_ptr<User> user = findUser(username);
+        if (user && user->checkPassword(password)) {
+            currentUser = std::move(user);
             return true;
         }
         return false;
@@ -40,6 +153,166 @@ public:
     bool isLoggedIn() const {
         return currentUser != nullptr;
     }
+
+    // Log in on a new session, independent of the current user and of any
+    // other session. Returns SessionTable::NoSession if the login fails.
+    SessionToken openSession(std::string_view username, const std::string& password) {
+        OpTimer timer(Operation::Login);
+        std::shared_ptr<User> user = findUser(username);
+        if (!user || !user->checkPassword(password)) {
+            return SessionTable::NoSession;
+        }
+        return sessions.open(std::move(user));
+    }
+
+    // False if the session was not open
+    bool closeSession(SessionToken token) {
+        return sessions.close(token);
+    }
+
+    // User behind an open session, or null. The User is not locked; use
+    // withSession to call into it from more than one thread.
+    std::shared_ptr<User> sessionUser(SessionToken token) const {
+        return sessions.find(token);
+    }
+
+    std::size_t sessionCount() const {
+        return sessions.size();
+    }
+
+    // Call action(User&) with the session's user locked. Returns false,
+    // without calling it, if the session is not open.
+    template <typename Action>
+    bool withSession(SessionToken token, Action&& action) {
+        std::shared_ptr<User> user = sessions.find(token);
+        if (!user) {
+            return false;
+        }
+        withUser(user, std::forward<Action>(action));
+        return true;
+    }
+
+    // Call action(User&) with 'user' locked. A compaction the log asks for
+    // meanwhile waits until the lock is released.
+    template <typename Action>
+    void withUser(const std::shared_ptr<User>& user, Action&& action) {
+        {
+            std::unique_lock<std::mutex> lock = user->lock();
+            HeldLock held;
+            action(*user);
+        }
+        runDeferredCheckpoint();
+    }
+
+    std::size_t userCount() const {
+        std::shared_lock<std::shared_mutex> lock(usersMutex);
+        return users.size();
+    }
+
+    std::shared_ptr<User> findUser(std::string_view username) const {
+        std::shared_lock<std::shared_mutex> lock(usersMutex);
+        auto it = lookup(username);
+        return it != users.end() ? it->second : nullptr;
+    }
+
+    // Lookup by a symbol from User::getUsernameSymbol; skips hashing the name
+    std::shared_ptr<User> findUser(Symbol username) const {
+        std::shared_lock<std::shared_mutex> lock(usersMutex);
+        auto it = users.find(username);
+        return it != users.end() ? it->second : nullptr;
+    }
+
+    // Write all users and tasks to a binary snapshot file. Every user is
+    // locked while the snapshot is encoded.
+    bool saveSnapshot(const std::string& path) const {
+        std::string contents;
+        {
+            std::shared_lock<std::shared_mutex> lock(usersMutex);
+            auto userLocks = lockAllUsers();
+            SnapshotCodec::encode(*this, contents);
+        }
+        return binio::writeFileAtomically(path, contents);
+    }
+
+    // Replace all users with the contents of a snapshot file; logs out the
+    // current user and closes every session
+    bool loadSnapshot(const std::string& path) {
+        std::string contents;
+        if (!binio::readFile(path, contents)) {
+            return false;
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(usersMutex);
+            if (!SnapshotCodec::decode(contents, *this)) {
+                return false;
+            }
+        }
+        sessions.clear();
+        attachLogToUsers();
+        return true;
+    }
+
+    // Restore state from the snapshot plus the mutation log written since,
+    // then log every further mutation. Either file may be missing.
+    bool openStorage(const std::string& snapshot, const std::string& logPath,
+                     const MutationLog::Options& options = MutationLog::Options()) {
+        log.reset();
+        if (!loadSnapshot(snapshot) && binio::fileExists(snapshot)) {
+            return false;  // Snapshot exists but is unreadable
+        }
+        std::uint64_t validBytes = 0;
+        std::uint64_t lastSequence = 0;
+        std::uint32_t logVersion = 0;
+        if (!MutationLog::replay(logPath, *this, snapshotSequence, validBytes, lastSequence, logVersion)) {
+            return false;
+        }
+        if (logVersion != 0 && logVersion < MutationLog::Version) {
+            // Older record formats are not appended to: fold the log into
+            // the snapshot and start a fresh one
+            snapshotSequence = lastSequence;
+            if (!saveSnapshot(snapshot)) {
+                return false;
+            }
+            validBytes = 0;
+        }
+        auto opened = std::make_unique<MutationLog>();
+        if (!opened->open(logPath, validBytes, lastSequence, options)) {
+            return false;
+        }
+        log = std::move(opened);
+        snapshotPath = snapshot;
+        log->setCompactionHandler([this] { requestCheckpoint(); });
+        attachLogToUsers();
+        return true;
+    }
+
+    // Fold the mutation log into a fresh snapshot and empty the log. Holds
+    // every user's lock throughout, so no record can slip in between the
+    // snapshot and the truncation.
+    bool checkpoint() {
+        if (!log) {
+            return false;
+        }
+        std::string contents;
+        std::shared_lock<std::shared_mutex> lock(usersMutex);
+        auto userLocks = lockAllUsers();
+        SnapshotCodec::encode(*this, contents);
+        if (!binio::writeFileAtomically(snapshotPath, contents)) {
+            return false;
+        }
+        snapshotSequence = log->lastSequence();
+        return log->truncate();
+    }
+
+    // Make every logged mutation durable
+    bool syncLog() {
+        return log && log->sync();
+    }
+
+    // Last mutation reflected in the in-memory state
+    std::uint64_t logSequence() const {
+        return log ? log->lastSequence() : snapshotSequence;
+    }
 };
 
 #endif
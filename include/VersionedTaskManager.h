@@ -0,0 +1,139 @@
+#ifndef VERSIONED_TASK_MANAGER_H
+#define VERSIONED_TASK_MANAGER_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "BaseTask.h"
+#include "StringInterner.h"
+#include "Task.h"
+#include "TaskStore.h"
+
+// Immutable, reference-counted view of a VersionedTaskManager at one point in
+// time. Readers iterate it without locks while writers publish newer versions.
+// It offers the TaskStore read interface, so the shared reports work on it.
+//
+// Rows live in fixed-size chunks, chunks are grouped into pages, and versions
+// share every chunk and page they have in common. Memory held by an old
+// version is released as soon as its last reader drops it.
+class TaskSnapshot {
+public:
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    static constexpr std::size_t ChunkBits = 8;
+    static constexpr std::size_t ChunkRows = std::size_t(1) << ChunkBits;
+    static constexpr std::size_t PageBits = 8;
+    static constexpr std::size_t PageChunks = std::size_t(1) << PageBits;
+
+    static constexpr std::uint8_t CompletedFlag = 1;
+    static constexpr std::uint8_t RemovedFlag = 2;
+
+    struct Chunk {
+        std::uint64_t generation = 0;  // Version that created this copy
+        std::array<std::string_view, ChunkRows> names;  // Point into the writer's interner
+        std::array<TimePoint, ChunkRows> deadlines;
+        std::array<int, ChunkRows> priorities;
+        std::array<int, ChunkRows> estimatedTimes;
+        std::array<std::uint8_t, ChunkRows> flags;
+        std::array<TaskKind, ChunkRows> kinds;
+    };
+
+    struct Page {
+        std::uint64_t generation = 0;
+        std::array<std::shared_ptr<const Chunk>, PageChunks> chunks;
+    };
+
+private:
+    std::vector<std::shared_ptr<const Page>> pages;
+    std::shared_ptr<const void> nameStorage;  // Keeps the strings behind 'names' alive
+    std::size_t rowCount = 0;
+    std::size_t liveCount = 0;
+    std::uint64_t version = 0;
+
+    const Chunk& chunk(TaskId id) const {
+        return *pages[id >> (ChunkBits + PageBits)]->chunks[(id >> ChunkBits) & (PageChunks - 1)];
+    }
+
+    friend class VersionedTaskManager;
+
+public:
+    std::uint64_t getVersion() const { return version; }
+
+    std::size_t capacity() const { return rowCount; }
+    std::size_t size() const { return liveCount; }
+    bool contains(TaskId id) const { return id < rowCount && !(chunk(id).flags[id & (ChunkRows - 1)] & RemovedFlag); }
+
+    std::string_view name(TaskId id) const { return chunk(id).names[id & (ChunkRows - 1)]; }
+    int priority(TaskId id) const { return chunk(id).priorities[id & (ChunkRows - 1)]; }
+    TimePoint deadline(TaskId id) const { return chunk(id).deadlines[id & (ChunkRows - 1)]; }
+    int estimatedTime(TaskId id) const { return chunk(id).estimatedTimes[id & (ChunkRows - 1)]; }
+    bool isCompleted(TaskId id) const { return chunk(id).flags[id & (ChunkRows - 1)] & CompletedFlag; }
+    TaskKind kind(TaskId id) const { return chunk(id).kinds[id & (ChunkRows - 1)]; }
+
+    // Call f(id) for every live task in ID order, one chunk at a time
+    template <typename F>
+    void forEach(F f) const {
+        for (std::size_t base = 0; base < rowCount; base += ChunkRows) {
+            const Chunk& rows = chunk(static_cast<TaskId>(base));
+            std::size_t end = std::min(ChunkRows, rowCount - base);
+            for (std::size_t row = 0; row < end; ++row) {
+                if (!(rows.flags[row] & RemovedFlag)) {
+                    f(static_cast<TaskId>(base + row));
+                }
+            }
+        }
+    }
+};
+
+// Task manager whose readers never block writers. Every mutation publishes a
+// new TaskSnapshot; readers grab the current one with snapshot() and keep a
+// consistent view for as long as they hold it. Writers serialize on a mutex.
+//
+// Appends write into slots no published version can see, so they copy
+// nothing; updates copy only the affected chunk and page.
+class VersionedTaskManager {
+private:
+    using Chunk = TaskSnapshot::Chunk;
+    using Page = TaskSnapshot::Page;
+
+    std::mutex writeMutex;
+    std::shared_ptr<StringInterner> names;  // Writer-only; snapshots keep it alive
+    std::vector<std::shared_ptr<Page>> pages;  // Working version
+    std::vector<TaskId> nextSameName; // Next live task with the same name, or npos
+    std::vector<TaskId> firstByName;  // Name symbol -> first live task
+    std::vector<TaskId> lastByName;   // Name symbol -> last live task, where new ones are chained
+    std::size_t rowCount = 0;
+    std::size_t liveCount = 0;
+    std::uint64_t publishedGeneration = 0;  // Objects with generation <= this are shared
+    std::shared_ptr<const TaskSnapshot> published;  // Accessed with std::atomic_load/store
+
+    Chunk& writableChunk(TaskId id);
+    void publish();
+
+public:
+    VersionedTaskManager();
+    VersionedTaskManager(const VersionedTaskManager&) = delete;
+    VersionedTaskManager& operator=(const VersionedTaskManager&) = delete;
+
+    TaskId addTask(std::unique_ptr<BaseTask> task);
+    TaskId addTask(const Task& task);
+    bool markTaskComplete(const std::string& taskName);
+    bool removeTask(const std::string& taskName);
+
+    // Current version; never blocks
+    std::shared_ptr<const TaskSnapshot> snapshot() const;
+
+    // Reports render from a snapshot without taking the write lock
+    void displayTasks(std::ostream& out) const;
+    void displayTasksByPriority(std::ostream& out) const;
+    void displaySortedTasks(std::ostream& out) const;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef WEEKLY_PLANNER_H
+#define WEEKLY_PLANNER_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "TaskStore.h"
+
+struct PlannerOptions {
+    std::chrono::system_clock::time_point start = std::chrono::system_clock::now();  // Day 0 begins here
+    int weeks = 52;
+    std::array<int, 7> hoursPerDay{{8, 8, 8, 8, 8, 0, 0}};  // Capacity of day d is hoursPerDay[d % 7]
+    bool localSearch = true;    // Try swaps that lower priority-weighted lateness
+    int localSearchPasses = 2;
+    int searchDays = 14;        // How far before a late piece to look for swap partners
+    int candidatesPerPiece = 256;
+};
+
+// Result of WeeklyPlanner::plan. A task longer than the biggest daily
+// capacity is split into day-sized pieces; every other task is one piece.
+// Lateness is counted in whole days: the day the task's last piece is
+// scheduled minus the day of its deadline.
+struct WeeklyPlan {
+    struct Slot {
+        TaskId id;
+        int day;
+        int hours;
+    };
+
+    std::vector<Slot> slots;             // Sorted by day
+    std::vector<int> hoursUsed;          // Per day
+    std::vector<TaskId> unscheduled;     // Did not fit before the end of the horizon
+    std::size_t plannedTasks = 0;
+    std::size_t lateTasks = 0;
+    long long totalLatenessDays = 0;
+    long long weightedLatenessDays = 0;  // Lateness times priority
+};
+
+// Packs open tasks into per-day working-hour capacities. Pieces are placed
+// earliest deadline first (higher priority first within a day), each on the
+// first day with room, found through a max-capacity segment tree. An
+// optional local search then moves or swaps pieces to cut weighted lateness.
+class WeeklyPlanner {
+public:
+    struct Item {
+        TaskId id;
+        int priority;
+        int estimatedTime;
+        int deadlineDay;  // Relative to day 0; negative if already overdue
+    };
+
+private:
+    PlannerOptions options;
+
+public:
+    explicit WeeklyPlanner(const PlannerOptions& opts = PlannerOptions()) : options(opts) {}
+
+    int dayOf(std::chrono::system_clock::time_point when) const;
+
+    WeeklyPlan plan(std::vector<Item> items) const;
+
+    // Plan every open task in 'store'
+    template <typename Store>
+    WeeklyPlan plan(const Store& store) const {
+        std::vector<Item> items;
+        items.reserve(store.size());
+        store.forEach([&](TaskId id) {
+            if (!store.isCompleted(id)) {
+                items.push_back(Item{id, store.priority(id), store.estimatedTime(id), dayOf(store.deadline(id))});
+            }
+        });
+        return plan(std::move(items));
+    }
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool with one job deque per worker. A worker runs jobs
+// from the front of its own deque; when that is empty it steals the back
+// half of another worker's deque. Jobs submitted in priority order therefore
+// run roughly highest first, while thieves take the least urgent work.
+// Jobs submitted from inside a job go to the submitting worker's deque.
+// A job that throws does not take its worker down: the first exception is
+// kept and rethrown by the next wait(), and later ones are dropped.
+class WorkStealingPool {
+public:
+    using Job = std::function<void()>;
+
+private:
+    // Padded to a cache line so neighbouring queue locks do not false-share
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::size_t threads;                        // Set before any worker starts
+    std::unique_ptr<Queue[]> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> nextQueue{0};      // Round-robin target for outside submissions
+    std::atomic<std::size_t> queued{0};         // Jobs sitting in some deque
+    std::atomic<std::size_t> unfinished{0};     // Jobs submitted but not yet run
+    std::atomic<std::size_t> sleepers{0};
+    std::atomic<std::uint64_t> stealCount{0};
+    std::atomic<bool> stopping{false};
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    std::mutex doneMutex;
+    std::condition_variable allDone;
+    std::exception_ptr firstError;              // Guarded by doneMutex
+
+    void workerLoop(std::size_t self);
+    bool popOwn(std::size_t self, Job& job);
+    bool stealInto(std::size_t self, Job& job);
+    void pushTo(std::size_t queue, Job job);
+    void wakeWorkers(std::size_t count);
+    void finished(std::size_t count);
+
+public:
+    explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency());
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool();
+
+    void submit(Job job);
+
+    // Spread the jobs round-robin over the workers, keeping their order within
+    // each deque. Locks every deque once rather than once per job.
+    void submitBatch(std::vector<Job>&& jobs);
+
+    // Block until every submitted job, including nested submissions, has
+    // run, then rethrow the first exception any of them threw
+    void wait();
+
+    std::size_t threadCount() const { return threads; }
+    std::uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+};
+
+#endif
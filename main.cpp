@@ -2,11 +2,12 @@
 #include <limits>
 #include <memory>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
 #include "UserManager.h"
-#include "AiTask.h"
-#include "HpcTask.h"
-#include "ProgrammingTask.h"
-#include "DevopsTask.h"
+#include "BatchRunner.h"
+#include "OpStats.h"
+#include "Task.h"
 
 // Function to get a valid menu option
 int getMenuOption(int min, int max) {
@@ -51,10 +52,62 @@ std::chrono::system_clock::time_point getDeadlineInput() {
     }
 }
 
-int main() {
+// Users and tasks are kept between runs in a snapshot plus a log of the changes since
+const char* const SnapshotPath = "tasks.snap";
+const char* const LogPath = "tasks.wal";
+
+// Non-interactive mode: apply the commands in 'path' ("-" for stdin), see
+// BatchRunner.h. Batches can simply be re-run, so the log is synced at the
+// end (or on a "sync" command) rather than after every change.
+int runBatch(const char* path) {
+    std::FILE* in = std::strcmp(path, "-") == 0 ? stdin : std::fopen(path, "rb");
+    if (in == nullptr) {
+        std::cerr << "Error: cannot open " << path << "\n";
+        return 1;
+    }
+    UserManager userManager;
+    MutationLog::Options storageOptions;
+    storageOptions.groupCommitSize = std::numeric_limits<std::size_t>::max();
+    if (!userManager.openStorage(SnapshotPath, LogPath, storageOptions)) {
+        std::cerr << "Warning: could not open " << SnapshotPath << " / " << LogPath
+                  << "; changes will not be saved.\n";
+    }
+
+    BatchResult result = BatchRunner(userManager).run(in, std::cout);
+    if (in != stdin) {
+        std::fclose(in);
+    }
+    if (!userManager.checkpoint()) {
+        std::cerr << "Warning: could not save tasks to " << SnapshotPath << "\n";
+    }
+    std::cerr << result.commands << " commands, " << result.failed << " failed\n";
+    return result.failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        if (std::strcmp(argv[1], "--batch") == 0 && argc <= 3) {
+            return runBatch(argc == 3 ? argv[2] : "-");
+        }
+        std::cerr << "usage: TaskManagerExec [--batch [FILE|-]]\n";
+        return 2;
+    }
+
     UserManager userManager;
     bool running = true;
 
+    // A person at the menu never notices the recording cost
+    OpStats::setEnabled(true);
+
+    // Missing files simply mean this is the first run. Interactive edits are
+    // rare, so every mutation is synced on its own.
+    MutationLog::Options storageOptions;
+    storageOptions.groupCommitSize = 1;
+    if (!userManager.openStorage(SnapshotPath, LogPath, storageOptions)) {
+        std::cout << "Warning: could not open " << SnapshotPath << " / " << LogPath
+                  << "; changes will not be saved.\n";
+    }
+
     while (running) {
         int option;
 
@@ -114,8 +167,9 @@ int main() {
             std::cout << "6. Mark Task as Complete\n";
             std::cout << "7. Logout\n";
             std::cout << "8. Exit\n";
+            std::cout << "9. Show Operation Statistics\n";
             std::cout << "Enter option: ";
-            option = getMenuOption(1, 8);
+            option = getMenuOption(1, 9);
 
             auto currentUser = userManager.getCurrentUser();
 
@@ -141,24 +195,9 @@ int main() {
 
                 auto deadline = getDeadlineInput();
 
-                std::unique_ptr<BaseTask> task;
-                switch (option) {
-                    case 1:
-                        task = std::make_unique<AiTask>(name, priority, estimatedTime);
-                        break;
-                    case 2:
-                        task = std::make_unique<HpcTask>(name, priority, estimatedTime);
-                        break;
-                    case 3:
-                        task = std::make_unique<ProgrammingTask>(name, priority, estimatedTime);
-                        break;
-                    case 4:
-                        task = std::make_unique<DevopsTask>(name, priority, estimatedTime);
-                        break;
-                }
-
-                task->setDeadline(deadline);
-                currentUser->addTask(std::move(task));
+                // Menu options 1-4 map onto the task kinds in declaration order
+                Task task(static_cast<TaskKind>(option - 1), name, priority, estimatedTime, deadline);
+                currentUser->addTask(task);
                 std::cout << "Task added successfully.\n";
 
             } else if (option == 5) {
@@ -182,9 +221,15 @@ int main() {
 
             } else if (option == 8) {
                 running = false;
+
+            } else if (option == 9) {
+                OpStats::snapshot().writeText(std::cout);
             }
         }
     }
 
+    if (!userManager.checkpoint()) {
+        std::cout << "Warning: could not save tasks to " << SnapshotPath << "\n";
+    }
     return 0;
 }
@@ -0,0 +1,102 @@
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include "OpStats.h"
+#include "TaskServer.h"
+#include "UserManager.h"
+
+// Local task service: serves the same users and tasks as TaskManagerExec
+// over a Unix domain socket and/or localhost TCP (see TaskProtocol.h).
+//
+//   TaskManagerServer [--unix PATH] [--tcp PORT] [--snapshot PATH] [--log PATH] [--stats]
+//
+// With no listener given it listens on ./taskmanager.sock. --stats records
+// operation latencies and prints them on shutdown.
+
+namespace {
+
+TaskServer* activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) {
+        activeServer->stop();
+    }
+}
+
+void printUsage() {
+    std::cerr << "usage: TaskManagerServer [--unix PATH] [--tcp PORT] [--snapshot PATH] [--log PATH] [--stats]\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string unixPath;
+    int tcpPort = -1;
+    std::string snapshotPath = "tasks.snap";
+    std::string logPath = "tasks.wal";
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--unix") == 0 && hasValue) {
+            unixPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tcp") == 0 && hasValue) {
+            tcpPort = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--snapshot") == 0 && hasValue) {
+            snapshotPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--log") == 0 && hasValue) {
+            logPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            OpStats::setEnabled(true);
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+    if (unixPath.empty() && tcpPort < 0) {
+        unixPath = "taskmanager.sock";
+    }
+
+    // The server syncs the log once per loop round, after all of the round's
+    // requests have run, so the record-count trigger is switched off
+    UserManager userManager;
+    MutationLog::Options storageOptions;
+    storageOptions.groupCommitSize = std::numeric_limits<std::size_t>::max();
+    if (!userManager.openStorage(snapshotPath, logPath, storageOptions)) {
+        std::cerr << "Warning: could not open " << snapshotPath << " / " << logPath
+                  << "; changes will not be saved.\n";
+    }
+
+    TaskServer server(userManager);
+    if (!unixPath.empty() && !server.listenUnix(unixPath)) {
+        std::cerr << "Error: cannot listen on " << unixPath << "\n";
+        return 1;
+    }
+    if (tcpPort >= 0 && !server.listenTcp(tcpPort)) {
+        std::cerr << "Error: cannot listen on 127.0.0.1:" << tcpPort << "\n";
+        return 1;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    if (!unixPath.empty()) {
+        std::cout << "Listening on " << unixPath << "\n";
+    }
+    if (tcpPort >= 0) {
+        std::cout << "Listening on 127.0.0.1:" << server.port() << "\n";
+    }
+    std::cout.flush();
+
+    bool ok = server.run();
+    activeServer = nullptr;
+    userManager.syncLog();
+    std::cout << "Served " << server.requestCount() << " requests\n";
+    if (OpStats::isEnabled()) {
+        OpStats::snapshot().writeText(std::cout);
+    }
+    return ok ? 0 : 1;
+}
@@ -1,7 +1,7 @@
 #include "AiTask.h"
 #include <iostream>
 
-AiTask::AiTask(std::string name, int priority, int estimatedTime)
+AiTask::AiTask(std::string_view name, int priority, int estimatedTime)
     : BaseTask(name, priority, estimatedTime) {}
 
 void AiTask::displayTask() const {
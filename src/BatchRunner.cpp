@@ -0,0 +1,305 @@
+#include "BatchRunner.h"
+#include <charconv>
+#include <sstream>
+#include "OpStats.h"
+#include "TaskImporter.h"
+#include "UserManager.h"
+
+namespace {
+
+constexpr std::size_t ReadBytes = 1 << 20;
+constexpr std::size_t OutputBytes = 1 << 20;  // Buffered output written once it grows past this
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+std::string_view trim(std::string_view text) {
+    std::size_t begin = 0;
+    std::size_t end = text.size();
+    while (begin < end && isSpace(text[begin])) {
+        ++begin;
+    }
+    while (end > begin && isSpace(text[end - 1])) {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+// Split off the first word of 'text'; 'text' keeps the rest, trimmed
+std::string_view nextWord(std::string_view& text) {
+    std::size_t end = 0;
+    while (end < text.size() && !isSpace(text[end])) {
+        ++end;
+    }
+    std::string_view word = text.substr(0, end);
+    text = trim(text.substr(end));
+    return word;
+}
+
+bool parseInt(std::string_view text, int& value) {
+    const char* end = text.data() + text.size();
+    auto parsed = std::from_chars(text.data(), end, value);
+    return !text.empty() && parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+bool parseDeadline(std::string_view text, std::chrono::system_clock::time_point& deadline) {
+    if (text == "-") {
+        deadline = std::chrono::system_clock::time_point();
+        return true;
+    }
+    return TaskImporter::parseDeadline(text, deadline);
+}
+
+}
+
+void BatchRunner::begin(std::ostream& stream) {
+    out = &stream;
+    result = BatchResult();
+}
+
+BatchResult BatchRunner::finish() {
+    applyPending();
+    writeOutput(true);
+    out = nullptr;
+    return result;
+}
+
+BatchResult BatchRunner::run(std::FILE* in, std::ostream& stream) {
+    begin(stream);
+    std::string buffer;
+    std::size_t used = 0;
+    for (;;) {
+        buffer.resize(used + ReadBytes);
+        std::size_t received = std::fread(&buffer[used], 1, ReadBytes, in);
+        used += received;
+        if (received == 0) {
+            break;
+        }
+        // Run every complete line; keep the partial last one for the next block
+        std::string_view text(buffer.data(), used);
+        std::size_t start = 0;
+        for (std::size_t end; (end = text.find('\n', start)) != std::string_view::npos; start = end + 1) {
+            executeLine(text.substr(start, end - start));
+        }
+        used -= start;
+        buffer.erase(0, start);
+    }
+    if (used > 0) {
+        executeLine(std::string_view(buffer.data(), used));
+    }
+    return finish();
+}
+
+BatchResult BatchRunner::runText(std::string_view text, std::ostream& stream) {
+    begin(stream);
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        executeLine(text.substr(start, end - start));
+        start = end + 1;
+    }
+    return finish();
+}
+
+void BatchRunner::executeLine(std::string_view line) {
+    ++result.lines;
+    std::string_view args = trim(line);
+    if (args.empty() || args[0] == '#') {
+        return;
+    }
+    std::string_view command = nextWord(args);
+    ++result.commands;
+
+    std::string error;
+    if (!execute(command, args, error)) {
+        ++result.failed;
+        if (result.firstFailedLine == 0) {
+            result.firstFailedLine = result.lines;
+        }
+        output->append("line ");
+        output->appendInt(static_cast<long long>(result.lines));
+        output->append(": ");
+        output->append(error);
+        output->append("\n");
+    }
+    writeOutput(false);
+}
+
+bool BatchRunner::execute(std::string_view command, std::string_view args, std::string& error) {
+    std::shared_ptr<User> user = users.getCurrentUser();
+
+    if (command == "add") {
+        if (!user) {
+            error = "not logged in";
+            return false;
+        }
+        if (user != pendingOwner) {
+            applyPending();
+            pendingOwner = user;
+        }
+        if (pendingCount == pending.size()) {
+            pending.emplace_back();
+        }
+        Task& task = pending[pendingCount];
+        std::string_view kindText = nextWord(args);
+        std::string_view priorityText = nextWord(args);
+        std::string_view hoursText = nextWord(args);
+        std::string_view deadlineText = nextWord(args);
+        if (!TaskImporter::parseKind(kindText, task.kind) || !parseInt(priorityText, task.priority) ||
+            task.priority < 1 || task.priority > 3 || !parseInt(hoursText, task.estimatedTime) ||
+            task.estimatedTime < 0 || !parseDeadline(deadlineText, task.deadline) || args.empty()) {
+            error = "expected: add KIND PRIORITY(1-3) HOURS DEADLINE NAME";
+            return false;
+        }
+        task.name.assign(args.data(), args.size());  // Reuses the slot's capacity
+        task.isCompleted = false;
+        if (++pendingCount == MaxPendingTasks) {
+            applyPending();
+            pendingOwner = user;
+        }
+        return true;
+    }
+
+    // Everything else observes or changes state the pending adds belong to
+    applyPending();
+
+    if (command == "register" || command == "login") {
+        std::string_view username = nextWord(args);
+        scratch.assign(args.data(), args.size());
+        if (username.empty() || scratch.empty() || scratch.find_first_of(" \t") != std::string::npos) {
+            error = command == "register" ? "expected: register USER PASSWORD" : "expected: login USER PASSWORD";
+            return false;
+        }
+        if (command == "register") {
+            if (!users.registerUser(username, scratch)) {
+                error = "username already exists";
+                return false;
+            }
+        } else if (!users.loginUser(username, scratch)) {
+            error = "invalid username or password";
+            return false;
+        }
+        return true;
+    }
+    if (command == "logout") {
+        users.logoutUser();
+        return true;
+    }
+    if (command == "sync") {
+        users.syncLog();
+        return true;
+    }
+    if (command == "stats") {
+        if (args.empty() || args == "json") {
+            std::ostringstream text;
+            StatsSnapshot stats = OpStats::snapshot();
+            if (args.empty()) {
+                stats.writeText(text);
+            } else {
+                stats.writeJson(text);
+            }
+            output->append(text.str());
+        } else if (args == "on" || args == "off") {
+            OpStats::setEnabled(args == "on");
+        } else if (args == "reset") {
+            OpStats::reset();
+        } else if (int calls = 0; args.substr(0, 7) == "sample " && parseInt(args.substr(7), calls) && calls > 0) {
+            OpStats::setSamplingInterval(static_cast<std::uint32_t>(calls));
+        } else {
+            error = "expected: stats [json|on|off|reset|sample N]";
+            return false;
+        }
+        return true;
+    }
+    if (command == "checkpoint") {
+        if (!users.checkpoint()) {
+            error = "could not write a checkpoint";
+            return false;
+        }
+        return true;
+    }
+
+    if (command != "complete" && command != "remove" && command != "update" && command != "list" &&
+        command != "deadlines") {
+        error = "unknown command \"";
+        error.append(command);
+        error.append("\"");
+        return false;
+    }
+    if (!user) {
+        error = "not logged in";
+        return false;
+    }
+    bool succeeded = false;
+    users.withUser(user, [&](User& locked) {
+        succeeded = executeForUser(command, args, locked, error);
+    });
+    return succeeded;
+}
+
+// The rest of execute, for commands on the logged-in user; the caller holds
+// the user's lock
+bool BatchRunner::executeForUser(std::string_view command, std::string_view args, User& user, std::string& error) {
+    const TaskStore& tasks = user.getTasks();
+    if (command == "list") {
+        OpTimer timer(Operation::ListTasks);
+        user.getPriorityIndex().forEachSorted([&](TaskId id) {
+            output->appendTask(tasks, id);
+        });
+        return true;
+    }
+    if (command == "deadlines") {
+        OpTimer timer(Operation::ListTasks);
+        user.renderTasksWithDeadlines(*output);
+        return true;
+    }
+
+    bool found;
+    if (command == "update") {
+        int priority;
+        std::chrono::system_clock::time_point deadline;
+        std::string_view priorityText = nextWord(args);
+        std::string_view deadlineText = nextWord(args);
+        if (!parseInt(priorityText, priority) || priority < 1 || priority > 3 ||
+            !parseDeadline(deadlineText, deadline) || args.empty()) {
+            error = "expected: update PRIORITY(1-3) DEADLINE NAME";
+            return false;
+        }
+        scratch.assign(args.data(), args.size());
+        found = user.updateTask(scratch, priority, deadline);
+    } else {
+        if (args.empty()) {
+            error = command == "complete" ? "expected: complete NAME" : "expected: remove NAME";
+            return false;
+        }
+        scratch.assign(args.data(), args.size());
+        found = command == "complete" ? user.markTaskComplete(scratch) : user.removeTask(scratch);
+    }
+    if (!found) {
+        error = "task \"" + scratch + "\" not found";
+        return false;
+    }
+    return true;
+}
+
+void BatchRunner::applyPending() {
+    if (pendingCount > 0 && pendingOwner) {
+        users.withUser(pendingOwner, [this](User& owner) {
+            owner.addTasks(pending.data(), pendingCount);
+        });
+    }
+    pendingCount = 0;
+    pendingOwner = nullptr;
+}
+
+void BatchRunner::writeOutput(bool force) {
+    if (out && (force || output->str().size() >= OutputBytes)) {
+        if (!output->str().empty()) {
+            output->flushTo(*out);
+        }
+    }
+}
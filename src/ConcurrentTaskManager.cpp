@@ -0,0 +1,96 @@
+#include "ConcurrentTaskManager.h"
+#include <functional>
+#include "TaskRenderer.h"
+#include "TaskReports.h"
+
+ConcurrentTaskManager::ConcurrentTaskManager(std::size_t requestedShards) : shardBits(0) {
+    while ((std::size_t(1) << shardBits) < requestedShards) {
+        ++shardBits;
+    }
+    shardCount = std::size_t(1) << shardBits;
+    shards.reset(new Shard[shardCount]);
+}
+
+std::size_t ConcurrentTaskManager::shardFor(std::string_view taskName) const {
+    return std::hash<std::string_view>()(taskName) & (shardCount - 1);
+}
+
+// The next ID of 'shard' still fits beside the shard bits, and the combined
+// ID cannot come out as npos
+bool ConcurrentTaskManager::hasIdFor(const Shard& shard) const {
+    return shard.manager.getStore().capacity() < (TaskStore::npos >> shardBits);
+}
+
+std::vector<std::unique_lock<std::mutex>> ConcurrentTaskManager::lockAll() const {
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        locks.emplace_back(shards[i].mutex);
+    }
+    return locks;
+}
+
+TaskId ConcurrentTaskManager::addTask(std::unique_ptr<BaseTask> task) {
+    std::size_t index = shardFor(task->getName());
+    Shard& shard = shards[index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!hasIdFor(shard)) {
+        return TaskStore::npos;
+    }
+    return static_cast<TaskId>((shard.manager.addTask(std::move(task)) << shardBits) | index);
+}
+
+TaskId ConcurrentTaskManager::addTask(const Task& task) {
+    std::size_t index = shardFor(task.name);
+    Shard& shard = shards[index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (!hasIdFor(shard)) {
+        return TaskStore::npos;
+    }
+    return static_cast<TaskId>((shard.manager.addTask(task) << shardBits) | index);
+}
+
+bool ConcurrentTaskManager::markTaskComplete(const std::string& taskName) {
+    Shard& shard = shards[shardFor(taskName)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.manager.markTaskComplete(taskName);
+}
+
+bool ConcurrentTaskManager::removeTask(const std::string& taskName) {
+    Shard& shard = shards[shardFor(taskName)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.manager.removeTask(taskName);
+}
+
+void ConcurrentTaskManager::displayTasks(std::ostream& out) const {
+    auto locks = lockAll();
+    TaskRenderer& renderer = TaskRenderer::local();
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        const TaskStore& store = shards[i].manager.getStore();
+        store.forEach([&](TaskId id) {
+            renderer.appendTask(store, id);
+        });
+    }
+    renderer.flushTo(out);
+}
+
+void ConcurrentTaskManager::displayTasksByPriority(std::ostream& out) const {
+    auto locks = lockAll();
+    std::vector<const TaskStore*> stores;
+    stores.reserve(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        stores.push_back(&shards[i].manager.getStore());
+    }
+    TaskRenderer& renderer = TaskRenderer::local();
+    reports::renderByPriority(stores, renderer);
+    renderer.flushTo(out);
+}
+
+std::size_t ConcurrentTaskManager::taskCount() const {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        count += shards[i].manager.taskCount();
+    }
+    return count;
+}
@@ -0,0 +1,100 @@
+#include "DeadlineWatcher.h"
+
+DeadlineWatcher::DeadlineWatcher(Callback callback)
+    : onExpired(std::move(callback)), worker([this] { run(); }) {}
+
+DeadlineWatcher::~DeadlineWatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_one();
+    worker.join();
+}
+
+void DeadlineWatcher::schedule(std::uint64_t key, TimePoint deadline) {
+    bool earliest;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t generation = ++nextGeneration;
+        live[key] = generation;
+        earliest = heap.empty() || deadline < heap.top().deadline;
+        heap.push(Entry{deadline, key, generation});
+        // The entry this replaces stays behind, so rescheduling one key over
+        // and over needs the same cleanup as cancelling
+        dropStaleEntries();
+    }
+    // Only a new earliest deadline changes how long the worker should sleep
+    if (earliest) {
+        wakeUp.notify_one();
+    }
+}
+
+void DeadlineWatcher::cancel(std::uint64_t key) {
+    // The heap entry stays behind and is skipped when it reaches the top
+    std::lock_guard<std::mutex> lock(mutex);
+    live.erase(key);
+    dropStaleEntries();
+}
+
+void DeadlineWatcher::dropStaleEntries() {
+    // Rebuild once cancelled or superseded entries dominate so memory stays bounded
+    if (heap.size() > 2 * live.size() + 64) {
+        std::vector<Entry> kept;
+        kept.reserve(live.size());
+        while (!heap.empty()) {
+            const Entry& entry = heap.top();
+            auto it = live.find(entry.key);
+            if (it != live.end() && it->second == entry.generation) {
+                kept.push_back(entry);
+            }
+            heap.pop();
+        }
+        heap = decltype(heap)(std::greater<Entry>(), std::move(kept));
+    }
+}
+
+std::size_t DeadlineWatcher::pending() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return live.size();
+}
+
+std::size_t DeadlineWatcher::queued() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return heap.size();
+}
+
+void DeadlineWatcher::run() {
+    std::vector<std::uint64_t> expired;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (heap.empty()) {
+            wakeUp.wait(lock);
+            continue;
+        }
+        TimePoint next = heap.top().deadline;
+        if (std::chrono::system_clock::now() <= next) {
+            wakeUp.wait_until(lock, next);
+            continue; // Re-check: woken early, stopped, or a new earliest entry
+        }
+
+        TimePoint now = std::chrono::system_clock::now();
+        while (!heap.empty() && heap.top().deadline < now) {
+            Entry entry = heap.top();
+            heap.pop();
+            auto it = live.find(entry.key);
+            if (it != live.end() && it->second == entry.generation) {
+                live.erase(it);
+                expired.push_back(entry.key);
+            }
+        }
+
+        // Run callbacks without the lock so they may schedule or cancel
+        lock.unlock();
+        for (std::uint64_t key : expired) {
+            onExpired(key);
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
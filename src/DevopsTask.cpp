@@ -1,7 +1,7 @@
 #include "DevopsTask.h"
 #include <iostream>
 
-DevopsTask::DevopsTask(std::string name, int priority, int estimatedTime)
+DevopsTask::DevopsTask(std::string_view name, int priority, int estimatedTime)
     : BaseTask(name, priority, estimatedTime) {}
 
 void DevopsTask::displayTask() const {
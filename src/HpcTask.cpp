@@ -1,7 +1,7 @@
 #include "HpcTask.h"
 #include <iostream>
 
-HpcTask::HpcTask(std::string name, int priority, int estimatedTime)
+HpcTask::HpcTask(std::string_view name, int priority, int estimatedTime)
     : BaseTask(name, priority, estimatedTime) {}
 
 void HpcTask::displayTask() const {
@@ -0,0 +1,119 @@
+#include "MappedTaskStore.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+MappedTaskStore::~MappedTaskStore() {
+    close();
+}
+
+bool MappedTaskStore::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HeaderSize) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping stays valid without the descriptor
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const char*>(mapping);
+    mappedBytes = bytes;
+
+    binio::Reader header(data, HeaderSize);
+    std::uint32_t magic = header.get<std::uint32_t>();
+    std::uint32_t version = header.get<std::uint32_t>();
+    std::uint64_t count = header.get<std::uint64_t>();
+    std::uint64_t live = header.get<std::uint64_t>();
+    std::uint64_t blobBytes = header.get<std::uint64_t>();
+    std::uint64_t available = bytes - HeaderSize;
+    if (magic != Magic || version != Version || count > available / RecordSize ||
+        blobBytes != available - count * RecordSize || live > count) {
+        close();
+        return false;
+    }
+    recordCount = static_cast<std::size_t>(count);
+    liveCount = static_cast<std::size_t>(live);
+    records = data + HeaderSize;
+    namesBlob = records + recordCount * RecordSize;
+    namesBytes = static_cast<std::size_t>(blobBytes);
+    return true;
+}
+
+void MappedTaskStore::close() {
+    if (data != nullptr) {
+        ::munmap(const_cast<char*>(data), mappedBytes);
+    }
+    data = nullptr;
+    mappedBytes = 0;
+    recordCount = 0;
+    liveCount = 0;
+    records = nullptr;
+    namesBlob = nullptr;
+    namesBytes = 0;
+}
+
+bool MappedTaskStore::write(const TaskStore& store, const std::string& path) {
+    std::size_t count = store.capacity();
+
+    // Each distinct name is written to the blob once
+    std::vector<std::uint32_t> nameOffsets;
+    std::string names;
+    std::string contents;
+    contents.reserve(HeaderSize + count * RecordSize);
+    binio::Writer writer(contents);
+    writer.put(Magic);
+    writer.put(Version);
+    writer.put(static_cast<std::uint64_t>(count));
+    writer.put(static_cast<std::uint64_t>(store.size()));
+    std::size_t blobSizeAt = contents.size();
+    writer.put(static_cast<std::uint64_t>(0)); // Patched once the blob is built
+
+    for (TaskId id = 0; id < count; ++id) {
+        Symbol symbol = store.nameSymbol(id);
+        if (symbol >= nameOffsets.size()) {
+            nameOffsets.resize(symbol + 1, static_cast<std::uint32_t>(-1));
+        }
+        if (nameOffsets[symbol] == static_cast<std::uint32_t>(-1)) {
+            nameOffsets[symbol] = static_cast<std::uint32_t>(names.size());
+            names.append(store.name(id));
+        }
+        std::uint8_t flags = (store.isCompleted(id) ? CompletedFlag : 0) | (store.contains(id) ? 0 : RemovedFlag);
+        writer.put(static_cast<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(store.deadline(id).time_since_epoch()).count()));
+        writer.put(nameOffsets[symbol]);
+        writer.put(static_cast<std::uint32_t>(store.name(id).size()));
+        writer.put(static_cast<std::int32_t>(store.priority(id)));
+        writer.put(static_cast<std::int32_t>(store.estimatedTime(id)));
+        writer.put(static_cast<std::uint8_t>(store.kind(id)));
+        writer.put(flags);
+        contents.append(6, '\0');
+    }
+    if (names.size() > 0xFFFFFFFFu) {
+        return false; // Offsets are 32-bit
+    }
+
+    std::string blobSize;
+    binio::Writer(blobSize).put(static_cast<std::uint64_t>(names.size()));
+    contents.replace(blobSizeAt, blobSize.size(), blobSize);
+    contents += names;
+    return binio::writeFileAtomically(path, contents);
+}
+
+TaskId MappedTaskStore::findByName(std::string_view taskName) const {
+    for (TaskId id = 0; id < recordCount; ++id) {
+        if (!(flags(id) & RemovedFlag) && name(id) == taskName) {
+            return id;
+        }
+    }
+    return TaskStore::npos;
+}
@@ -0,0 +1,348 @@
+#include "MutationLog.h"
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include "BinaryIO.h"
+#include "UserManager.h"
+
+namespace {
+
+using Nanoseconds = std::chrono::duration<std::int64_t, std::nano>;
+
+constexpr std::size_t HeaderBytes = 8;
+constexpr std::size_t RecordPrefixBytes = 8;
+
+std::uint32_t checksum(const char* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u; // FNV-1a
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool writeAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+}
+
+MutationLog::~MutationLog() {
+    close();
+}
+
+bool MutationLog::open(const std::string& logPath, std::uint64_t validBytes, std::uint64_t lastSequence,
+                       const Options& opts) {
+    close();
+    fd = ::open(logPath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    path = logPath;
+    options = opts;
+    sequence = lastSequence;
+
+    if (validBytes < HeaderBytes) {
+        // New or unusable file: start over with a fresh header
+        validBytes = 0;
+    }
+    if (::ftruncate(fd, static_cast<off_t>(validBytes)) != 0) {
+        close();
+        return false;
+    }
+    fileBytes = validBytes;
+    if (fileBytes == 0) {
+        std::string header;
+        binio::Writer writer(header);
+        writer.put(Magic);
+        writer.put(Version);
+        if (!writeAll(fd, header.data(), header.size()) || ::fdatasync(fd) != 0) {
+            close();
+            return false;
+        }
+        fileBytes = header.size();
+    }
+    return true;
+}
+
+void MutationLog::close() {
+    if (isOpen()) {
+        sync();
+        std::lock_guard<std::mutex> lock(mutex);
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+void MutationLog::beginRecord(MutationType type, std::string_view username, std::size_t& bodyStart) {
+    bodyStart = pending.size() + RecordPrefixBytes;
+    pending.append(RecordPrefixBytes, '\0'); // Length and checksum, filled in by endRecord
+    binio::Writer writer(pending);
+    writer.put(++sequence);
+    writer.put(static_cast<std::uint8_t>(type));
+    writer.putString(username);
+}
+
+void MutationLog::sealRecord(std::size_t bodyStart) {
+    std::uint32_t length = static_cast<std::uint32_t>(pending.size() - bodyStart);
+    std::string prefix;
+    binio::Writer writer(prefix);
+    writer.put(length);
+    writer.put(checksum(pending.data() + bodyStart, length));
+    pending.replace(bodyStart - RecordPrefixBytes, RecordPrefixBytes, prefix);
+    ++pendingRecords;
+}
+
+void MutationLog::endRecord(std::size_t bodyStart, std::unique_lock<std::mutex>& lock) {
+    sealRecord(bodyStart);
+    commitIfDue(lock);
+}
+
+void MutationLog::commitIfDue(std::unique_lock<std::mutex>& lock) {
+    if (pendingRecords >= options.groupCommitSize) {
+        bool due = writePending() && compactionDue();
+        lock.unlock();
+        if (due) {
+            compact();
+        }
+    }
+}
+
+void MutationLog::appendRegisterUser(std::string_view username, const PasswordHash& password) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    std::size_t bodyStart;
+    beginRecord(MutationType::RegisterUser, username, bodyStart);
+    binio::Writer writer(pending);
+    writer.putArray(password.salt.data(), PasswordHash::SaltBytes);
+    writer.putArray(password.digest.data(), PasswordHash::DigestBytes);
+    endRecord(bodyStart, lock);
+}
+
+void MutationLog::encodeAddTask(std::string_view username, const TaskStore& store, TaskId id) {
+    std::size_t bodyStart;
+    beginRecord(MutationType::AddTask, username, bodyStart);
+    binio::Writer writer(pending);
+    writer.putString(store.name(id));
+    writer.put(static_cast<std::uint8_t>(store.kind(id)));
+    writer.put(static_cast<std::int32_t>(store.priority(id)));
+    writer.put(static_cast<std::int32_t>(store.estimatedTime(id)));
+    writer.put(static_cast<std::int64_t>(
+        std::chrono::duration_cast<Nanoseconds>(store.deadline(id).time_since_epoch()).count()));
+    writer.put(static_cast<std::uint8_t>(store.isCompleted(id) ? 1 : 0));
+    sealRecord(bodyStart);
+}
+
+void MutationLog::appendAddTask(std::string_view username, const TaskStore& store, TaskId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    encodeAddTask(username, store, id);
+    commitIfDue(lock);
+}
+
+void MutationLog::appendAddTasks(std::string_view username, const TaskStore& store, TaskId first, TaskId last) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    for (TaskId id = first; id < last; ++id) {
+        encodeAddTask(username, store, id);
+    }
+    commitIfDue(lock);
+}
+
+void MutationLog::appendCompleteTask(std::string_view username, std::string_view taskName) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    std::size_t bodyStart;
+    beginRecord(MutationType::CompleteTask, username, bodyStart);
+    binio::Writer(pending).putString(taskName);
+    endRecord(bodyStart, lock);
+}
+
+void MutationLog::appendRemoveTask(std::string_view username, std::string_view taskName) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    std::size_t bodyStart;
+    beginRecord(MutationType::RemoveTask, username, bodyStart);
+    binio::Writer(pending).putString(taskName);
+    endRecord(bodyStart, lock);
+}
+
+void MutationLog::appendUpdateTask(std::string_view username, const TaskStore& store, TaskId id) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return;
+    }
+    std::size_t bodyStart;
+    beginRecord(MutationType::UpdateTask, username, bodyStart);
+    binio::Writer writer(pending);
+    writer.putString(store.name(id));
+    writer.put(static_cast<std::int32_t>(store.priority(id)));
+    writer.put(static_cast<std::int64_t>(
+        std::chrono::duration_cast<Nanoseconds>(store.deadline(id).time_since_epoch()).count()));
+    endRecord(bodyStart, lock);
+}
+
+bool MutationLog::writePending() {
+    if (!pending.empty()) {
+        if (!writeAll(fd, pending.data(), pending.size()) || ::fdatasync(fd) != 0) {
+            return false;
+        }
+        fileBytes += pending.size();
+        pending.clear();
+        pendingRecords = 0;
+        ++syncCount;
+    }
+    return true;
+}
+
+bool MutationLog::compactionDue() const {
+    return fileBytes >= options.compactionBytes && onCompaction;
+}
+
+void MutationLog::compact() {
+    // The handler usually truncates the log, which must not recurse into it
+    if (!compacting.exchange(true)) {
+        onCompaction();
+        compacting = false;
+    }
+}
+
+bool MutationLog::sync() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return false;
+    }
+    if (!writePending()) {
+        return false;
+    }
+    bool due = compactionDue();
+    lock.unlock();
+    if (due) {
+        compact();
+    }
+    return true;
+}
+
+bool MutationLog::truncate() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd < 0) {
+        return false;
+    }
+    pending.clear();
+    pendingRecords = 0;
+    if (::ftruncate(fd, static_cast<off_t>(HeaderBytes)) != 0 || ::fdatasync(fd) != 0) {
+        return false;
+    }
+    fileBytes = HeaderBytes;
+    return true;
+}
+
+bool MutationLog::replay(const std::string& logPath, UserManager& manager, std::uint64_t afterSequence,
+                         std::uint64_t& validBytes, std::uint64_t& lastSequence, std::uint32_t& fileVersion) {
+    validBytes = 0;
+    lastSequence = afterSequence;
+    fileVersion = 0;
+    std::string contents;
+    if (!binio::readFile(logPath, contents)) {
+        return ::access(logPath.c_str(), F_OK) != 0; // Only a missing file is fine
+    }
+    if (contents.size() < HeaderBytes) {
+        return true; // Crashed while creating the log
+    }
+
+    binio::Reader header(contents.data(), HeaderBytes);
+    if (header.get<std::uint32_t>() != Magic) {
+        return false;
+    }
+    fileVersion = header.get<std::uint32_t>();
+    if (fileVersion < 1 || fileVersion > Version) {
+        return false;
+    }
+    std::size_t offset = HeaderBytes;
+    validBytes = offset;
+
+    while (contents.size() - offset >= RecordPrefixBytes) {
+        binio::Reader prefix(contents.data() + offset, RecordPrefixBytes);
+        std::uint32_t length = prefix.get<std::uint32_t>();
+        std::uint32_t expected = prefix.get<std::uint32_t>();
+        const char* body = contents.data() + offset + RecordPrefixBytes;
+        if (length > contents.size() - offset - RecordPrefixBytes || checksum(body, length) != expected) {
+            break; // Torn or corrupt tail
+        }
+
+        binio::Reader reader(body, length);
+        std::uint64_t recordSequence = reader.get<std::uint64_t>();
+        auto type = static_cast<MutationType>(reader.get<std::uint8_t>());
+        std::string_view username = reader.getString();
+        if (!reader.ok()) {
+            break;
+        }
+
+        if (recordSequence > afterSequence) {
+            if (type == MutationType::RegisterUser) {
+                if (fileVersion >= 2) {
+                    PasswordHash password;
+                    reader.getArray(password.salt.data(), PasswordHash::SaltBytes);
+                    reader.getArray(password.digest.data(), PasswordHash::DigestBytes);
+                    if (reader.ok()) {
+                        manager.registerUser(username, password);
+                    }
+                } else {
+                    manager.registerUser(username, std::string(reader.getString()));
+                }
+            } else if (std::shared_ptr<User> user = manager.findUser(username)) {
+                if (type == MutationType::AddTask) {
+                    Task task;
+                    task.name = std::string(reader.getString());
+                    std::uint8_t kind = reader.get<std::uint8_t>();
+                    if (kind >= TaskKindCount) {
+                        break; // Corrupt despite its checksum; stop like a bad tail
+                    }
+                    task.kind = static_cast<TaskKind>(kind);
+                    task.priority = reader.get<std::int32_t>();
+                    task.estimatedTime = reader.get<std::int32_t>();
+                    task.deadline = TaskStore::TimePoint(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        Nanoseconds(reader.get<std::int64_t>())));
+                    task.isCompleted = reader.get<std::uint8_t>() != 0;
+                    if (reader.ok()) {
+                        user->addTask(task);
+                    }
+                } else if (type == MutationType::CompleteTask) {
+                    user->markTaskComplete(std::string(reader.getString()));
+                } else if (type == MutationType::RemoveTask) {
+                    user->removeTask(std::string(reader.getString()));
+                } else if (type == MutationType::UpdateTask) {
+                    std::string taskName(reader.getString());
+                    int priority = reader.get<std::int32_t>();
+                    TaskStore::TimePoint deadline(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        Nanoseconds(reader.get<std::int64_t>())));
+                    if (reader.ok()) {
+                        user->updateTask(taskName, priority, deadline);
+                    }
+                }
+            }
+            lastSequence = recordSequence;
+        }
+        offset += RecordPrefixBytes + length;
+        validBytes = offset;
+    }
+    return true;
+}
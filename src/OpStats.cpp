@@ -0,0 +1,266 @@
+#include "OpStats.h"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+std::atomic<bool> OpStats::enabledFlag{false};
+std::atomic<std::uint32_t> OpStats::interval{OpStats::DefaultSamplingInterval};
+
+namespace {
+
+using ThreadBuffer = OpStats::ThreadBuffer;
+
+// Fold 'buffer' into plain totals
+void accumulate(const ThreadBuffer& buffer, StatsSnapshot& into) {
+    for (int op = 0; op < OperationCount; ++op) {
+        const ThreadBuffer::Counters& from = buffer.operations[op];
+        OperationStats& to = into.operations[op];
+        to.count += from.count.load(std::memory_order_relaxed);
+        to.totalTicks += from.totalTicks.load(std::memory_order_relaxed);
+        to.maxTicks = std::max(to.maxTicks, from.maxTicks.load(std::memory_order_relaxed));
+        for (int b = 0; b < OperationStats::BucketCount; ++b) {
+            to.buckets[b] += from.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Buffers of live threads, totals of exited ones, and the reset() baseline
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadBuffer*> live;
+    StatsSnapshot retired;
+    StatsSnapshot baseline;
+
+    // Timestamp counter and steady clock read together at start-up; the
+    // tick rate is measured against them whenever a snapshot is taken
+    std::uint64_t startTicks = OpStats::now();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+};
+
+// Never destroyed, so threads that exit during static destruction can still
+// hand their buffers back
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+// Set once the thread's slot is gone; calls made later in thread exit
+// (from other thread_local destructors) are dropped into 'discarded'
+thread_local bool slotDestroyed = false;
+ThreadBuffer discarded;
+
+// Registers the thread's buffer on first use and retires it at thread exit
+class ThreadSlot {
+private:
+    std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+    ThreadBuffer** cached;  // The thread's OpStats fast-path pointer
+
+public:
+    explicit ThreadSlot(ThreadBuffer** cache) : cached(cache) {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.live.push_back(buffer.get());
+    }
+
+    ~ThreadSlot() {
+        *cached = nullptr;
+        slotDestroyed = true;
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        accumulate(*buffer, shared.retired);
+        shared.live.erase(std::find(shared.live.begin(), shared.live.end(), buffer.get()));
+    }
+
+    ThreadBuffer& get() { return *buffer; }
+};
+
+double ticksPerNanosecond(Registry& shared) {
+#if defined(__x86_64__) || defined(__i386__)
+    // Measure over at least a millisecond so the ratio is meaningful
+    auto elapsed = std::chrono::steady_clock::now() - shared.startTime;
+    while (elapsed < std::chrono::milliseconds(1)) {
+        std::this_thread::yield();
+        elapsed = std::chrono::steady_clock::now() - shared.startTime;
+    }
+    std::uint64_t ticks = OpStats::now() - shared.startTicks;
+    return static_cast<double>(ticks) / std::chrono::duration<double, std::nano>(elapsed).count();
+#else
+    (void)shared;
+    return 1;  // now() already counts steady_clock nanoseconds
+#endif
+}
+
+// Print a latency with a unit that keeps three significant digits
+void writeLatency(std::ostream& out, double nanoseconds) {
+    static const char* const units[] = {"ns", "us", "ms", "s"};
+    int unit = 0;
+    while (nanoseconds >= 1000 && unit < 3) {
+        nanoseconds /= 1000;
+        ++unit;
+    }
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(nanoseconds < 10 ? 2 : nanoseconds < 100 ? 1 : 0) << nanoseconds
+         << ' ' << units[unit];
+    out << std::setw(11) << text.str();
+}
+
+}
+
+const char* operationName(Operation operation) {
+    switch (operation) {
+        case Operation::AddTask: return "add_task";
+        case Operation::CompleteTask: return "complete_task";
+        case Operation::ListTasks: return "list_tasks";
+        case Operation::Login: return "login";
+        default: return "register_user";
+    }
+}
+
+double OperationStats::meanNanoseconds() const {
+    return samples == 0 ? 0 : totalTicks / ticksPerNanosecond / samples;
+}
+
+double OperationStats::percentileNanoseconds(double fraction) const {
+    if (samples == 0) {
+        return 0;
+    }
+    std::uint64_t rank = static_cast<std::uint64_t>(fraction * (samples - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < BucketCount; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            // Middle of the bucket, but never above the largest sample
+            double low = static_cast<double>(bucketStart(b));
+            double high = b + 1 < BucketCount ? static_cast<double>(bucketStart(b + 1)) : low;
+            double middle = std::min((low + high) / 2, static_cast<double>(maxTicks));
+            return middle / ticksPerNanosecond;
+        }
+    }
+    return maxNanoseconds();
+}
+
+OpStats::ThreadBuffer& OpStats::attachThread() {
+    if (slotDestroyed) {
+        return discarded;
+    }
+    static thread_local ThreadSlot slot(&localBuffer);
+    localBuffer = &slot.get();
+    return *localBuffer;
+}
+
+void OpStats::record(Operation operation, std::uint64_t ticks) {
+    ThreadBuffer* buffer = localBuffer != nullptr ? localBuffer : &attachThread();
+    ThreadBuffer::Counters& counters = buffer->operations[static_cast<int>(operation)];
+    bump(counters.buckets[OperationStats::bucketOf(ticks)], 1);
+    bump(counters.totalTicks, ticks);
+    if (ticks > counters.maxTicks.load(std::memory_order_relaxed)) {
+        counters.maxTicks.store(ticks, std::memory_order_relaxed);
+    }
+}
+
+StatsSnapshot OpStats::snapshot() {
+    Registry& shared = registry();
+    StatsSnapshot merged;
+    double rate;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        merged = shared.retired;
+        for (const ThreadBuffer* buffer : shared.live) {
+            accumulate(*buffer, merged);
+        }
+        // Remove what was there at the last reset()
+        for (int op = 0; op < OperationCount; ++op) {
+            OperationStats& stats = merged.operations[op];
+            const OperationStats& base = shared.baseline.operations[op];
+            stats.count -= base.count;
+            stats.totalTicks -= base.totalTicks;
+            for (int b = 0; b < OperationStats::BucketCount; ++b) {
+                stats.buckets[b] -= base.buckets[b];
+            }
+        }
+        rate = ticksPerNanosecond(shared);
+    }
+    merged.enabled = isEnabled();
+    merged.samplingInterval = samplingInterval();
+    for (OperationStats& stats : merged.operations) {
+        stats.ticksPerNanosecond = rate;
+        stats.samples = 0;
+        for (std::uint64_t n : stats.buckets) {
+            stats.samples += n;
+        }
+        if (stats.samples == 0) {
+            stats.maxTicks = 0;
+        }
+    }
+    return merged;
+}
+
+void OpStats::reset() {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    StatsSnapshot current = shared.retired;
+    for (ThreadBuffer* buffer : shared.live) {
+        accumulate(*buffer, current);
+        // Counts only grow, so they are rebased; the maximum is simply cleared
+        for (ThreadBuffer::Counters& counters : buffer->operations) {
+            counters.maxTicks.store(0, std::memory_order_relaxed);
+        }
+    }
+    shared.baseline = current;
+    for (OperationStats& stats : shared.retired.operations) {
+        stats.maxTicks = 0;
+    }
+}
+
+void StatsSnapshot::writeText(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    out << std::left << std::setw(15) << "operation" << std::right << std::setw(11) << "count" << std::setw(11)
+        << "mean" << std::setw(11) << "p50" << std::setw(11) << "p90" << std::setw(11) << "p99" << std::setw(11)
+        << "p99.9" << std::setw(11) << "max" << "\n";
+    for (int op = 0; op < OperationCount; ++op) {
+        const OperationStats& stats = operations[op];
+        if (stats.count == 0) {
+            continue;
+        }
+        out << std::left << std::setw(15) << operationName(static_cast<Operation>(op)) << std::right
+            << std::setw(11) << stats.count;
+        writeLatency(out, stats.meanNanoseconds());
+        for (double fraction : {0.5, 0.9, 0.99, 0.999}) {
+            writeLatency(out, stats.percentileNanoseconds(fraction));
+        }
+        writeLatency(out, stats.maxNanoseconds());
+        out << "\n";
+    }
+    if (samplingInterval > 1) {
+        out << "(latencies from 1 in " << samplingInterval << " calls)\n";
+    }
+    if (!enabled) {
+        out << "(recording is off)\n";
+    }
+    out.flags(flags);
+}
+
+void StatsSnapshot::writeJson(std::ostream& out) const {
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "{\"enabled\":" << (enabled ? "true" : "false") << ",\"sampling_interval\":" << samplingInterval
+        << ",\"operations\":{";
+    bool first = true;
+    for (int op = 0; op < OperationCount; ++op) {
+        const OperationStats& stats = operations[op];
+        out << (first ? "" : ",") << '"' << operationName(static_cast<Operation>(op)) << "\":{\"count\":"
+            << stats.count << ",\"samples\":" << stats.samples << std::fixed << std::setprecision(1) << ",\"mean_ns\":" << stats.meanNanoseconds()
+            << ",\"p50_ns\":" << stats.percentileNanoseconds(0.5)
+            << ",\"p90_ns\":" << stats.percentileNanoseconds(0.9)
+            << ",\"p99_ns\":" << stats.percentileNanoseconds(0.99)
+            << ",\"p999_ns\":" << stats.percentileNanoseconds(0.999)
+            << ",\"max_ns\":" << stats.maxNanoseconds() << "}";
+        first = false;
+    }
+    out << "}}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
@@ -1,7 +1,7 @@
 #include "ProgrammingTask.h"
 #include <iostream>
 
-ProgrammingTask::ProgrammingTask(std::string name, int priority, int estimatedTime)
+ProgrammingTask::ProgrammingTask(std::string_view name, int priority, int estimatedTime)
     : BaseTask(name, priority, estimatedTime) {}
 
 void ProgrammingTask::displayTask() const {
@@ -0,0 +1,176 @@
+#include "Scheduler.h"
+#include <algorithm>
+
+namespace {
+
+double hoursBetween(std::chrono::system_clock::time_point from, std::chrono::system_clock::time_point to) {
+    return std::chrono::duration<double, std::ratio<3600>>(to - from).count();
+}
+
+}
+
+Scheduler::Scheduler(const ScheduleOptions& opts) : options(opts) {}
+
+void Scheduler::rank(Entry& entry) const {
+    double horizon = static_cast<double>(options.starvationHorizon.count());
+    entry.band = 1;
+    switch (options.policy) {
+    case SchedulePolicy::EarliestDeadline:
+        entry.rank = 0; // Deadline is the tie-break
+        break;
+    case SchedulePolicy::WeightedShortestJob:
+        entry.rank = -static_cast<double>(entry.priority) / std::max(1, entry.estimatedTime);
+        break;
+    case SchedulePolicy::Hybrid:
+        if (entry.deadlineHours <= horizon) {
+            entry.band = 0;
+            entry.rank = 0;
+        } else {
+            entry.rank = -static_cast<double>(entry.priority) / std::max(1, entry.estimatedTime);
+        }
+        break;
+    }
+}
+
+void Scheduler::invalidate(TaskId id) {
+    if (id >= generations.size()) {
+        generations.resize(id + 1, 0);
+        positions.resize(id + 1, NotPlanned);
+    }
+    ++generations[id];
+    if (positions[id] != NotPlanned) {
+        dirtyFrom = std::min<std::size_t>(dirtyFrom, positions[id]);
+        positions[id] = NotPlanned;
+    }
+}
+
+void Scheduler::add(TaskId id, int priority, int estimatedTime, std::chrono::system_clock::time_point deadline) {
+    invalidate(id);
+    Entry entry;
+    entry.deadlineHours = hoursBetween(options.start, deadline);
+    entry.id = id;
+    entry.priority = priority;
+    entry.estimatedTime = estimatedTime;
+    entry.generation = generations[id];
+    rank(entry);
+    pending.push_back(entry);
+}
+
+void Scheduler::remove(TaskId id) {
+    invalidate(id);
+}
+
+void Scheduler::setOptions(const ScheduleOptions& opts) {
+    double shift = hoursBetween(opts.start, options.start);
+    options = opts;
+    for (Entry& entry : plan) {
+        entry.deadlineHours += shift;
+        rank(entry);
+    }
+    for (Entry& entry : pending) {
+        entry.deadlineHours += shift;
+        rank(entry);
+    }
+    // Re-sort everything by merging the old plan in as if it were new
+    pending.insert(pending.end(), plan.begin(), plan.end());
+    plan.clear();
+    dirtyFrom = 0;
+}
+
+void Scheduler::replan() {
+    Before before;
+    std::size_t from = std::min(dirtyFrom, plan.size());
+    if (!pending.empty()) {
+        std::sort(pending.begin(), pending.end(), before);
+        std::size_t insertAt = std::lower_bound(plan.begin(), plan.end(), pending.front(), before) - plan.begin();
+        from = std::min(from, insertAt);
+    }
+    if (from == plan.size() && pending.empty()) {
+        replanned = 0;
+        return;
+    }
+
+    // Merge the live tail of the plan with the new entries
+    auto live = [this](const Entry& entry) { return entry.generation == generations[entry.id]; };
+    std::vector<Entry> tail;
+    tail.reserve(plan.size() - from + pending.size());
+    auto a = plan.begin() + static_cast<std::ptrdiff_t>(from);
+    auto b = pending.begin();
+    while (a != plan.end() || b != pending.end()) {
+        const Entry& next = (b == pending.end() || (a != plan.end() && before(*a, *b))) ? *a++ : *b++;
+        if (live(next)) {
+            tail.push_back(next);
+        }
+    }
+    plan.resize(from);
+    plan.insert(plan.end(), tail.begin(), tail.end());
+    pending.clear();
+    dirtyFrom = plan.size();
+
+    // Re-time from the first changed position; the prefix is still correct
+    finishHours.resize(plan.size());
+    latenessTotals.resize(plan.size());
+    latenessMaxima.resize(plan.size());
+    lateCounts.resize(plan.size());
+    double clock = from > 0 ? finishHours[from - 1] : 0;
+    double total = from > 0 ? latenessTotals[from - 1] : 0;
+    double maximum = from > 0 ? latenessMaxima[from - 1] : 0;
+    std::uint32_t late = from > 0 ? lateCounts[from - 1] : 0;
+    for (std::size_t i = from; i < plan.size(); ++i) {
+        const Entry& entry = plan[i];
+        positions[entry.id] = static_cast<std::uint32_t>(i);
+        clock += std::max(0, entry.estimatedTime);
+        double lateness = std::max(0.0, clock - entry.deadlineHours);
+        total += lateness;
+        maximum = std::max(maximum, lateness);
+        late += lateness > 0 ? 1 : 0;
+        finishHours[i] = clock;
+        latenessTotals[i] = total;
+        latenessMaxima[i] = maximum;
+        lateCounts[i] = late;
+    }
+    replanned = plan.size() - from;
+}
+
+PlannedTask Scheduler::planned(std::size_t position) const {
+    const Entry& entry = plan[position];
+    double finish = finishHours[position];
+    return PlannedTask{entry.id, finish - std::max(0, entry.estimatedTime), finish,
+                       std::max(0.0, finish - entry.deadlineHours)};
+}
+
+std::size_t Scheduler::size() {
+    replan();
+    return plan.size();
+}
+
+ScheduleSummary Scheduler::summary() {
+    replan();
+    ScheduleSummary result;
+    if (!plan.empty()) {
+        result.tasks = plan.size();
+        result.lateTasks = lateCounts.back();
+        result.totalLatenessHours = latenessTotals.back();
+        result.maxLatenessHours = latenessMaxima.back();
+    }
+    return result;
+}
+
+std::vector<TaskId> Scheduler::order() {
+    replan();
+    std::vector<TaskId> ids;
+    ids.reserve(plan.size());
+    for (const Entry& entry : plan) {
+        ids.push_back(entry.id);
+    }
+    return ids;
+}
+
+bool Scheduler::find(TaskId id, PlannedTask& slot) {
+    replan();
+    if (id >= positions.size() || positions[id] == NotPlanned) {
+        return false;
+    }
+    slot = planned(positions[id]);
+    return true;
+}
@@ -0,0 +1,66 @@
+#include "SessionTable.h"
+#include <random>
+
+namespace {
+
+// Tokens come from a per-thread generator, so opening sessions on several
+// threads shares no state beyond the target shard
+SessionToken randomToken() {
+    static thread_local std::mt19937_64 generator(std::random_device{}());
+    SessionToken token;
+    do {
+        token = generator();
+    } while (token == SessionTable::NoSession);
+    return token;
+}
+
+}
+
+SessionTable::SessionTable(std::size_t shardCount) {
+    std::size_t count = 1;
+    while (count < shardCount) {
+        count <<= 1;
+    }
+    shardMask = count - 1;
+    shards.reset(new Shard[count]);
+}
+
+SessionToken SessionTable::open(std::shared_ptr<User> user) {
+    while (true) {
+        SessionToken token = randomToken();
+        Shard& shard = shardFor(token);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.sessions.emplace(token, user).second) {
+            return token;
+        }
+    }
+}
+
+bool SessionTable::close(SessionToken token) {
+    Shard& shard = shardFor(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.sessions.erase(token) != 0;
+}
+
+std::shared_ptr<User> SessionTable::find(SessionToken token) const {
+    Shard& shard = shardFor(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(token);
+    return it != shard.sessions.end() ? it->second : nullptr;
+}
+
+void SessionTable::clear() {
+    for (std::size_t i = 0; i <= shardMask; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        shards[i].sessions.clear();
+    }
+}
+
+std::size_t SessionTable::size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i <= shardMask; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+        total += shards[i].sessions.size();
+    }
+    return total;
+}
@@ -0,0 +1,183 @@
+#include "Snapshot.h"
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "BinaryIO.h"
+#include "StringInterner.h"
+#include "UserManager.h"
+
+namespace {
+
+using Nanoseconds = std::chrono::duration<std::int64_t, std::nano>;
+
+}
+
+void SnapshotCodec::encode(const UserManager& manager, std::string& out) {
+    // Gather every distinct string into one table and remember how each
+    // user's local name symbols map onto it.
+    StringInterner table;
+    std::vector<std::vector<Symbol>> nameRemaps;
+    nameRemaps.reserve(manager.users.size());
+    std::size_t totalRows = 0;
+    for (const auto& entry : manager.users) {
+        const User& user = *entry.second;
+        table.intern(user.username);
+        const StringInterner& names = user.tasks.names;
+        std::vector<Symbol> remap(names.size());
+        for (Symbol local = 0; local < names.size(); ++local) {
+            remap[local] = table.intern(names.view(local));
+        }
+        nameRemaps.push_back(std::move(remap));
+        totalRows += user.tasks.capacity();
+    }
+
+    out.clear();
+    out.reserve(16 + table.size() * 16 + manager.users.size() * UserHeaderBytes + totalRows * 22);
+    binio::Writer writer(out);
+    writer.put(Magic);
+    writer.put(Version);
+    writer.put(manager.logSequence());
+    writer.put(static_cast<std::uint32_t>(table.size()));
+    writer.put(static_cast<std::uint32_t>(manager.users.size()));
+    for (Symbol symbol = 0; symbol < table.size(); ++symbol) {
+        writer.putString(table.view(symbol));
+    }
+
+    std::vector<std::uint32_t> names;
+    std::vector<std::int64_t> deadlines;
+    std::size_t userIndex = 0;
+    for (const auto& entry : manager.users) {
+        const User& user = *entry.second;
+        const TaskStore& store = user.tasks;
+        const std::vector<Symbol>& remap = nameRemaps[userIndex++];
+        std::size_t rows = store.capacity();
+
+        writer.put(static_cast<std::uint32_t>(table.find(user.username)));
+        writer.putArray(user.password.salt.data(), PasswordHash::SaltBytes);
+        writer.putArray(user.password.digest.data(), PasswordHash::DigestBytes);
+        writer.put(static_cast<std::uint32_t>(rows));
+
+        names.resize(rows);
+        deadlines.resize(rows);
+        for (std::size_t row = 0; row < rows; ++row) {
+            names[row] = remap[store.nameColumn[row]];
+            deadlines[row] = std::chrono::duration_cast<Nanoseconds>(store.deadlines[row].time_since_epoch()).count();
+        }
+        static_assert(sizeof(int) == 4, "snapshot stores int columns as 32-bit");
+        static_assert(sizeof(TaskKind) == 1, "snapshot stores kinds as bytes");
+        writer.putArray(names.data(), rows);
+        writer.putArray(store.priorities.data(), rows);
+        writer.putArray(store.estimatedTimes.data(), rows);
+        writer.putArray(deadlines.data(), rows);
+        writer.putArray(store.flags.data(), rows);
+        writer.putArray(reinterpret_cast<const std::uint8_t*>(store.kinds.data()), rows);
+    }
+}
+
+bool SnapshotCodec::decode(std::string_view data, UserManager& manager) {
+    binio::Reader reader(data.data(), data.size());
+    if (reader.get<std::uint32_t>() != Magic) {
+        return false;
+    }
+    std::uint32_t version = reader.get<std::uint32_t>();
+    if (version < 1 || version > Version) {
+        return false;
+    }
+    std::uint64_t sequence = version >= 2 ? reader.get<std::uint64_t>() : 0;
+    std::uint32_t stringCount = reader.get<std::uint32_t>();
+    std::uint32_t userCount = reader.get<std::uint32_t>();
+    // Every string needs at least its length prefix
+    if (!reader.ok() || stringCount > reader.remaining() / 4) {
+        return false;
+    }
+
+    std::vector<std::string_view> table(stringCount);
+    for (auto& text : table) {
+        text = reader.getString();
+    }
+
+    // Table index -> symbol in the user currently being loaded
+    std::vector<Symbol> remap(stringCount, StringInterner::npos);
+    std::vector<std::uint32_t> touched;
+    std::vector<std::uint32_t> names;
+    std::vector<std::int64_t> deadlines;
+
+    std::unordered_map<Symbol, std::shared_ptr<User>> users;
+    users.reserve(userCount);
+    for (std::uint32_t u = 0; u < userCount && reader.ok(); ++u) {
+        std::uint32_t usernameRef = reader.get<std::uint32_t>();
+        PasswordHash password;
+        std::uint32_t passwordRef = 0;
+        if (version >= 3) {
+            reader.getArray(password.salt.data(), PasswordHash::SaltBytes);
+            reader.getArray(password.digest.data(), PasswordHash::DigestBytes);
+        } else {
+            passwordRef = reader.get<std::uint32_t>();  // Plaintext in the string table
+        }
+        std::uint32_t rows = reader.get<std::uint32_t>();
+        // Each row takes 22 bytes across the columns
+        if (!reader.ok() || usernameRef >= stringCount || passwordRef >= stringCount || rows > reader.remaining() / 22) {
+            return false;
+        }
+        if (version < 3) {
+            password = PasswordHash::create(table[passwordRef]);
+        }
+
+        auto user = std::make_shared<User>(table[usernameRef], password);
+        TaskStore& store = user->tasks;
+        store.reserve(rows);
+        store.names.reserve(rows);
+        store.nameColumn.resize(rows);
+        store.priorities.resize(rows);
+        store.estimatedTimes.resize(rows);
+        store.flags.resize(rows);
+        store.kinds.resize(rows);
+        names.resize(rows);
+        deadlines.resize(rows);
+        reader.getArray(names.data(), rows);
+        reader.getArray(store.priorities.data(), rows);
+        reader.getArray(store.estimatedTimes.data(), rows);
+        reader.getArray(deadlines.data(), rows);
+        reader.getArray(store.flags.data(), rows);
+        reader.getArray(reinterpret_cast<std::uint8_t*>(store.kinds.data()), rows);
+        if (!reader.ok()) {
+            return false;
+        }
+
+        store.deadlines.resize(rows);
+        for (std::uint32_t row = 0; row < rows; ++row) {
+            std::uint32_t ref = names[row];
+            if (ref >= stringCount || static_cast<int>(store.kinds[row]) >= TaskKindCount ||
+                store.flags[row] > (TaskStore::CompletedFlag | TaskStore::RemovedFlag)) {
+                return false;
+            }
+            if (remap[ref] == StringInterner::npos) {
+                remap[ref] = store.names.intern(table[ref]);
+                touched.push_back(ref);
+            }
+            store.nameColumn[row] = remap[ref];
+            store.deadlines[row] = TaskStore::TimePoint(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(Nanoseconds(deadlines[row])));
+        }
+        for (std::uint32_t ref : touched) {
+            remap[ref] = StringInterner::npos;
+        }
+        touched.clear();
+        store.rebuildNameIndex();
+        user->rebuildIndexes();
+
+        Symbol username = user->usernameSymbol;
+        if (!users.emplace(username, std::move(user)).second) {
+            return false; // Duplicate username
+        }
+    }
+    if (!reader.ok() || !reader.atEnd()) {
+        return false;
+    }
+
+    manager.users = std::move(users);
+    manager.currentUser = nullptr;
+    manager.snapshotSequence = sequence;
+    return true;
+}
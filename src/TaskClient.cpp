@@ -0,0 +1,288 @@
+#include "TaskClient.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+using Nanoseconds = std::chrono::duration<std::int64_t, std::nano>;
+
+}
+
+TaskClient::~TaskClient() {
+    disconnect();
+}
+
+bool TaskClient::connectUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (fd >= 0 || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    int socketFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0) {
+        return false;
+    }
+    if (::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socketFd);
+        return false;
+    }
+    fd = socketFd;
+    return true;
+}
+
+bool TaskClient::connectTcp(const std::string& host, int port) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    if (fd >= 0 || ::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        return false;
+    }
+    int socketFd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0) {
+        return false;
+    }
+    if (::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socketFd);
+        return false;
+    }
+    int enable = 1;
+    ::setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    fd = socketFd;
+    return true;
+}
+
+void TaskClient::disconnect() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    output.clear();
+    input.clear();
+    inputOffset = 0;
+}
+
+std::size_t TaskClient::beginRequest(protocol::Opcode opcode) {
+    std::size_t frame = protocol::beginFrame(output);
+    binio::Writer writer(output);
+    writer.put(nextRequestId);
+    writer.put(static_cast<std::uint8_t>(opcode));
+    return frame;
+}
+
+std::uint32_t TaskClient::sendRegister(std::string_view username, std::string_view password) {
+    std::size_t frame = beginRequest(protocol::Opcode::Register);
+    binio::Writer writer(output);
+    writer.putString(username);
+    writer.putString(password);
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+std::uint32_t TaskClient::sendLogin(std::string_view username, std::string_view password) {
+    std::size_t frame = beginRequest(protocol::Opcode::Login);
+    binio::Writer writer(output);
+    writer.putString(username);
+    writer.putString(password);
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+std::uint32_t TaskClient::sendLogout() {
+    std::size_t frame = beginRequest(protocol::Opcode::Logout);
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+std::uint32_t TaskClient::sendAddTask(const Task& task) {
+    std::size_t frame = beginRequest(protocol::Opcode::AddTask);
+    binio::Writer writer(output);
+    writer.put(static_cast<std::uint8_t>(task.kind));
+    writer.putString(task.name);
+    writer.put(static_cast<std::int32_t>(task.priority));
+    writer.put(static_cast<std::int32_t>(task.estimatedTime));
+    writer.put(static_cast<std::int64_t>(
+        std::chrono::duration_cast<Nanoseconds>(task.deadline.time_since_epoch()).count()));
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+std::uint32_t TaskClient::sendMarkTaskComplete(std::string_view name) {
+    std::size_t frame = beginRequest(protocol::Opcode::MarkTaskComplete);
+    binio::Writer writer(output);
+    writer.putString(name);
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+std::uint32_t TaskClient::sendListTasks(std::uint32_t limit, const RemoteTask* after) {
+    std::size_t frame = beginRequest(protocol::Opcode::ListTasks);
+    binio::Writer writer(output);
+    writer.put(limit);
+    writer.put(static_cast<std::uint8_t>(after ? 1 : 0));
+    if (after) {
+        writer.put(static_cast<std::int32_t>(after->task.priority));
+        writer.put(static_cast<std::int64_t>(
+            std::chrono::duration_cast<Nanoseconds>(after->task.deadline.time_since_epoch()).count()));
+        writer.put(after->id);
+    }
+    protocol::endFrame(output, frame);
+    return nextRequestId++;
+}
+
+bool TaskClient::flush() {
+    std::size_t offset = 0;
+    while (offset < output.size()) {
+        ssize_t sent = ::send(fd, output.data() + offset, output.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        offset += static_cast<std::size_t>(sent);
+    }
+    output.clear();
+    return true;
+}
+
+bool TaskClient::receive(Response& response) {
+    for (;;) {
+        std::string_view body;
+        std::size_t frameBytes = 0;
+        protocol::FrameState state = protocol::nextFrame(input.data() + inputOffset, input.size() - inputOffset,
+                                                         body, frameBytes);
+        if (state == protocol::FrameState::TooLarge) {
+            return false;
+        }
+        if (state == protocol::FrameState::Complete) {
+            binio::Reader reader(body.data(), body.size());
+            response.requestId = reader.get<std::uint32_t>();
+            response.status = static_cast<protocol::Status>(reader.get<std::uint8_t>());
+            if (!reader.ok()) {
+                return false;
+            }
+            response.fields.assign(body.data() + 5, body.size() - 5);
+            inputOffset += frameBytes;
+            if (inputOffset == input.size()) {
+                input.clear();
+                inputOffset = 0;
+            }
+            return true;
+        }
+
+        // Need more bytes: compact, then read as much as is available
+        if (inputOffset > 0) {
+            input.erase(0, inputOffset);
+            inputOffset = 0;
+        }
+        std::size_t used = input.size();
+        input.resize(used + 64 * 1024);
+        ssize_t received = ::recv(fd, &input[used], input.size() - used, 0);
+        input.resize(used + (received > 0 ? static_cast<std::size_t>(received) : 0));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+    }
+}
+
+protocol::Status TaskClient::registerUser(std::string_view username, std::string_view password) {
+    sendRegister(username, password);
+    Response response;
+    return flush() && receive(response) ? response.status : protocol::Status::BadRequest;
+}
+
+protocol::Status TaskClient::login(std::string_view username, std::string_view password) {
+    sendLogin(username, password);
+    Response response;
+    return flush() && receive(response) ? response.status : protocol::Status::BadRequest;
+}
+
+protocol::Status TaskClient::addTask(const Task& task, std::uint32_t* taskId) {
+    sendAddTask(task);
+    Response response;
+    if (!flush() || !receive(response)) {
+        return protocol::Status::BadRequest;
+    }
+    if (response.status == protocol::Status::Ok && taskId) {
+        binio::Reader reader(response.fields.data(), response.fields.size());
+        *taskId = reader.get<std::uint32_t>();
+    }
+    return response.status;
+}
+
+protocol::Status TaskClient::markTaskComplete(std::string_view name) {
+    sendMarkTaskComplete(name);
+    Response response;
+    return flush() && receive(response) ? response.status : protocol::Status::BadRequest;
+}
+
+protocol::Status TaskClient::listTasks(std::vector<RemoteTask>& tasks) {
+    tasks.clear();
+    std::vector<RemoteTask> page;
+    for (;;) {
+        sendListTasks(0, tasks.empty() ? nullptr : &tasks.back());
+        Response response;
+        if (!flush() || !receive(response)) {
+            return protocol::Status::BadRequest;
+        }
+        if (response.status != protocol::Status::Ok) {
+            return response.status;
+        }
+        bool more = false;
+        if (!decodeTaskList(response.fields, page, nullptr, &more)) {
+            return protocol::Status::BadRequest;
+        }
+        std::move(page.begin(), page.end(), std::back_inserter(tasks));
+        if (page.empty() || !more) {
+            return protocol::Status::Ok;
+        }
+    }
+}
+
+bool TaskClient::decodeTaskList(std::string_view fields, std::vector<RemoteTask>& tasks, std::uint32_t* total,
+                                bool* more) {
+    binio::Reader reader(fields.data(), fields.size());
+    std::uint32_t taskCount = reader.get<std::uint32_t>();
+    std::uint8_t remaining = reader.get<std::uint8_t>();
+    std::uint32_t count = reader.get<std::uint32_t>();
+    if (total) {
+        *total = taskCount;
+    }
+    if (more) {
+        *more = remaining != 0;
+    }
+    tasks.clear();
+    // Each entry is at least 26 bytes; don't trust the count beyond that
+    if (!reader.ok() || count > reader.remaining() / 26) {
+        return false;
+    }
+    tasks.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        RemoteTask entry;
+        entry.id = reader.get<std::uint32_t>();
+        std::uint8_t kind = reader.get<std::uint8_t>();
+        entry.task.name = std::string(reader.getString());
+        entry.task.priority = reader.get<std::int32_t>();
+        entry.task.estimatedTime = reader.get<std::int32_t>();
+        entry.task.deadline = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(Nanoseconds(reader.get<std::int64_t>())));
+        entry.task.isCompleted = reader.get<std::uint8_t>() != 0;
+        if (!reader.ok() || kind >= TaskKindCount) {
+            return false;
+        }
+        entry.task.kind = static_cast<TaskKind>(kind);
+        tasks.push_back(std::move(entry));
+    }
+    return reader.atEnd();
+}
@@ -0,0 +1,252 @@
+#include "TaskGraph.h"
+#include <algorithm>
+
+void TaskGraph::reserve(std::size_t count) {
+    if (count <= states.capacity()) {
+        return;
+    }
+    count = std::max(count, states.capacity() * 2);
+    dependents.reserve(count);
+    prerequisites.reserve(count);
+    waitingOn.reserve(count);
+    estimatedTimes.reserve(count);
+    states.reserve(count);
+    positions.reserve(count);
+    visited.reserve(count);
+    topoOrder.reserve(count);
+    readyQueue.reserve(count);
+}
+
+void TaskGraph::addTask(TaskId id, int estimatedTime, bool completed) {
+    if (id >= states.size()) {
+        std::size_t size = id + 1;
+        dependents.resize(size);
+        prerequisites.resize(size);
+        waitingOn.resize(size, 0);
+        estimatedTimes.resize(size, 0);
+        states.resize(size, 0);
+        positions.resize(size, NoPosition);
+        visited.resize(size, 0);
+    }
+    estimatedTimes[id] = estimatedTime;
+    if (has(id, Present)) {
+        return;
+    }
+    states[id] = static_cast<std::uint8_t>(Present | (completed ? Done : 0));
+    waitingOn[id] = 0;
+    if (positions[id] == NoPosition) {
+        // A task without edges can go anywhere, so new tasks go last
+        positions[id] = static_cast<std::uint32_t>(topoOrder.size());
+        topoOrder.push_back(id);
+    }
+    if (!completed) {
+        readyQueue.push_back(id);
+    }
+}
+
+bool TaskGraph::addDependency(TaskId task, TaskId prerequisite) {
+    if (task == prerequisite || !has(task, Present) || !has(prerequisite, Present)) {
+        return false;
+    }
+    const std::vector<TaskId>& existing = prerequisites[task];
+    if (std::find(existing.begin(), existing.end(), prerequisite) != existing.end()) {
+        return true;
+    }
+    if (positions[prerequisite] > positions[task] && !reorder(prerequisite, task)) {
+        return false;
+    }
+    dependents[prerequisite].push_back(task);
+    prerequisites[task].push_back(prerequisite);
+    ++edgeCount;
+    if (!has(prerequisite, Done)) {
+        ++waitingOn[task];
+    }
+    return true;
+}
+
+bool TaskGraph::reorder(TaskId prerequisite, TaskId task) {
+    // 'task' currently sits before 'prerequisite'. Collect everything reachable
+    // from 'task' up to the prerequisite's position, and everything reaching
+    // 'prerequisite' down to the task's position, then swap the two groups.
+    std::uint32_t lower = positions[task];
+    std::uint32_t upper = positions[prerequisite];
+    forward.clear();
+    backward.clear();
+
+    bool cycle = false;
+    stack.assign(1, task);
+    visited[task] = 1;
+    while (!stack.empty() && !cycle) {
+        TaskId node = stack.back();
+        stack.pop_back();
+        forward.push_back(node);
+        for (TaskId next : dependents[node]) {
+            if (next == prerequisite) {
+                cycle = true;
+                break;
+            }
+            if (!visited[next] && positions[next] < upper) {
+                visited[next] = 1;
+                stack.push_back(next);
+            }
+        }
+    }
+    if (cycle) {
+        for (TaskId node : forward) {
+            visited[node] = 0;
+        }
+        for (TaskId node : stack) {
+            visited[node] = 0;
+        }
+        return false;
+    }
+
+    stack.assign(1, prerequisite);
+    visited[prerequisite] = 1;
+    while (!stack.empty()) {
+        TaskId node = stack.back();
+        stack.pop_back();
+        backward.push_back(node);
+        for (TaskId previous : prerequisites[node]) {
+            if (!visited[previous] && positions[previous] > lower) {
+                visited[previous] = 1;
+                stack.push_back(previous);
+            }
+        }
+    }
+
+    auto byPosition = [this](TaskId a, TaskId b) { return positions[a] < positions[b]; };
+    std::sort(forward.begin(), forward.end(), byPosition);
+    std::sort(backward.begin(), backward.end(), byPosition);
+    std::vector<std::uint32_t> slots;
+    slots.reserve(forward.size() + backward.size());
+    for (TaskId node : backward) {
+        slots.push_back(positions[node]);
+    }
+    for (TaskId node : forward) {
+        slots.push_back(positions[node]);
+    }
+    std::sort(slots.begin(), slots.end());
+
+    // The prerequisite's ancestors take the earliest slots, in their old order
+    std::size_t slot = 0;
+    for (const std::vector<TaskId>* group : {&backward, &forward}) {
+        for (TaskId node : *group) {
+            positions[node] = slots[slot];
+            topoOrder[slots[slot]] = node;
+            visited[node] = 0;
+            ++slot;
+        }
+    }
+    return true;
+}
+
+void TaskGraph::release(TaskId id, std::vector<TaskId>* released) {
+    for (TaskId next : dependents[id]) {
+        if (has(next, Present) && !has(next, Done) && --waitingOn[next] == 0) {
+            readyQueue.push_back(next);
+            if (released) {
+                released->push_back(next);
+            }
+        }
+    }
+}
+
+void TaskGraph::markComplete(TaskId id, std::vector<TaskId>* released) {
+    if (!has(id, Present) || has(id, Done)) {
+        return;
+    }
+    states[id] |= Done;
+    release(id, released);
+}
+
+void TaskGraph::removeTask(TaskId id, std::vector<TaskId>* released) {
+    if (!has(id, Present)) {
+        return;
+    }
+    if (!has(id, Done)) {
+        release(id, released);
+    }
+    // Drop the edges so they cannot cause false cycles later
+    for (TaskId next : dependents[id]) {
+        std::vector<TaskId>& list = prerequisites[next];
+        list.erase(std::find(list.begin(), list.end(), id));
+    }
+    for (TaskId previous : prerequisites[id]) {
+        std::vector<TaskId>& list = dependents[previous];
+        list.erase(std::find(list.begin(), list.end(), id));
+    }
+    edgeCount -= dependents[id].size() + prerequisites[id].size();
+    dependents[id].clear();
+    prerequisites[id].clear();
+    states[id] = 0;
+}
+
+bool TaskGraph::popReady(TaskId& id) {
+    while (readyHead < readyQueue.size()) {
+        TaskId next = readyQueue[readyHead++];
+        if (isReady(next) && !has(next, HandedOut)) {
+            states[next] |= HandedOut;
+            id = next;
+            return true;
+        }
+    }
+    readyQueue.clear();
+    readyHead = 0;
+    return false;
+}
+
+std::vector<TaskId> TaskGraph::topologicalOrder() const {
+    std::vector<TaskId> order;
+    order.reserve(topoOrder.size());
+    for (TaskId id : topoOrder) {
+        if (has(id, Present)) {
+            order.push_back(id);
+        }
+    }
+    return order;
+}
+
+std::vector<int> TaskGraph::earliestFinishTimes() const {
+    std::vector<int> finish(states.size(), 0);
+    for (TaskId id : topoOrder) {
+        if (!has(id, Present) || has(id, Done)) {
+            continue;
+        }
+        int start = 0;
+        for (TaskId previous : prerequisites[id]) {
+            start = std::max(start, finish[previous]); // 0 for completed prerequisites
+        }
+        finish[id] = start + estimatedTimes[id];
+    }
+    return finish;
+}
+
+CriticalPath TaskGraph::criticalPath() const {
+    CriticalPath path;
+    std::vector<int> finish(states.size(), 0);
+    std::vector<TaskId> via(states.size(), TaskStore::npos);
+    TaskId last = TaskStore::npos;
+    for (TaskId id : topoOrder) {
+        if (!has(id, Present) || has(id, Done)) {
+            continue;
+        }
+        int start = 0;
+        for (TaskId previous : prerequisites[id]) {
+            if (finish[previous] > start) {
+                start = finish[previous];
+                via[id] = previous;
+            }
+        }
+        finish[id] = start + estimatedTimes[id];
+        if (last == TaskStore::npos || finish[id] > path.length) {
+            path.length = finish[id];
+            last = id;
+        }
+    }
+    for (TaskId id = last; id != TaskStore::npos; id = via[id]) {
+        path.tasks.push_back(id);
+    }
+    std::reverse(path.tasks.begin(), path.tasks.end());
+    return path;
+}
@@ -0,0 +1,690 @@
+#include "TaskImporter.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include "UserManager.h"
+#include "WorkStealingPool.h"
+
+namespace {
+
+constexpr std::uint32_t NoOwner = 0xFFFFFFFFu;
+
+std::string_view trim(std::string_view text) {
+    std::size_t begin = 0;
+    std::size_t end = text.size();
+    while (begin < end && (text[begin] == ' ' || text[begin] == '\t')) {
+        ++begin;
+    }
+    while (end > begin && (text[end - 1] == ' ' || text[end - 1] == '\t')) {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+bool parseInt(std::string_view text, int& value) {
+    text = trim(text);
+    if (!text.empty() && text[0] == '+') {
+        text.remove_prefix(1);
+    }
+    const char* end = text.data() + text.size();
+    auto parsed = std::from_chars(text.data(), end, value);
+    return !text.empty() && parsed.ec == std::errc() && parsed.ptr == end;
+}
+
+// Parse exactly 'digits' decimal digits at text[pos]
+bool parseDigits(std::string_view text, std::size_t pos, std::size_t digits, int& value) {
+    if (pos + digits > text.size()) {
+        return false;
+    }
+    value = 0;
+    for (std::size_t i = pos; i < pos + digits; ++i) {
+        if (text[i] < '0' || text[i] > '9') {
+            return false;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+bool equalsLower(std::string_view text, const char* lower) {
+    std::size_t length = std::strlen(lower);
+    if (text.size() != length) {
+        return false;
+    }
+    for (std::size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int daysInMonth(int year, int month) {
+    static const int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+long long daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    long long yearOfEra = year - era * 400;
+    long long dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Fields of one record, viewing either the input or a scratch buffer
+struct Fields {
+    std::string_view name;
+    std::string_view kind;
+    std::string_view priority;
+    std::string_view estimatedTime;
+    std::string_view deadline;
+    std::string_view owner;
+    bool hasName = false;
+    bool hasKind = false;
+    bool hasPriority = false;
+    bool hasEstimatedTime = false;
+    bool hasOwner = false;
+};
+
+// Scratch buffers for fields that needed unescaping, one per field
+struct Scratch {
+    std::string buffers[6];
+};
+
+// Read one CSV field starting at 'pos'; leaves 'pos' after the separator
+bool csvField(std::string_view line, std::size_t& pos, std::string_view& field, std::string& scratch) {
+    if (pos < line.size() && line[pos] == '"') {
+        std::size_t start = ++pos;
+        bool escaped = false;
+        for (;;) {
+            const void* found = pos < line.size() ? std::memchr(line.data() + pos, '"', line.size() - pos) : nullptr;
+            if (found == nullptr) {
+                return false; // Unterminated quote
+            }
+            std::size_t quote = static_cast<const char*>(found) - line.data();
+            if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                if (!escaped) {
+                    scratch.assign(line.data() + start, quote - start);
+                    escaped = true;
+                } else {
+                    scratch.append(line.data() + pos, quote - pos);
+                }
+                scratch.push_back('"');
+                pos = quote + 2;
+                continue;
+            }
+            if (escaped) {
+                scratch.append(line.data() + pos, quote - pos);
+                field = scratch;
+            } else {
+                field = line.substr(start, quote - start);
+            }
+            pos = quote + 1;
+            break;
+        }
+        if (pos < line.size() && line[pos] != ',') {
+            return false; // Text after the closing quote
+        }
+    } else {
+        const void* found = pos < line.size() ? std::memchr(line.data() + pos, ',', line.size() - pos) : nullptr;
+        std::size_t end = found != nullptr ? static_cast<const char*>(found) - line.data() : line.size();
+        field = line.substr(pos, end - pos);
+        pos = end;
+    }
+    if (pos < line.size()) {
+        ++pos; // Skip the comma
+        return true;
+    }
+    pos = line.size() + 1; // Mark the line as consumed
+    return true;
+}
+
+bool parseCsvLine(std::string_view line, Fields& fields, Scratch& scratch) {
+    std::string_view* slots[6] = {&fields.name, &fields.kind, &fields.priority,
+                                  &fields.estimatedTime, &fields.deadline, &fields.owner};
+    std::size_t pos = 0;
+    for (int i = 0; i < 6; ++i) {
+        if (pos > line.size() || !csvField(line, pos, *slots[i], scratch.buffers[i])) {
+            return false;
+        }
+    }
+    if (pos <= line.size()) {
+        return false; // More than six fields
+    }
+    fields.hasName = fields.hasKind = fields.hasPriority = fields.hasEstimatedTime = fields.hasOwner = true;
+    return true;
+}
+
+void skipSpace(std::string_view line, std::size_t& pos) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+        ++pos;
+    }
+}
+
+void appendUtf8(std::string& out, std::uint32_t code) {
+    if (code < 0x80) {
+        out.push_back(static_cast<char>(code));
+    } else if (code < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else if (code < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+    }
+}
+
+bool hex4(std::string_view line, std::size_t pos, std::uint32_t& code) {
+    if (pos + 4 > line.size()) {
+        return false;
+    }
+    code = 0;
+    for (std::size_t i = pos; i < pos + 4; ++i) {
+        char c = line[i];
+        code <<= 4;
+        if (c >= '0' && c <= '9') {
+            code |= static_cast<std::uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            code |= static_cast<std::uint32_t>(c - 'a' + 10);
+        } else if (c >= 'A' && c <= 'F') {
+            code |= static_cast<std::uint32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Read a JSON string at 'pos' (which must be a quote). Strings without
+// escapes are returned as a view of the line; others are decoded into 'scratch'.
+bool jsonString(std::string_view line, std::size_t& pos, std::string_view& value, std::string& scratch) {
+    if (pos >= line.size() || line[pos] != '"') {
+        return false;
+    }
+    std::size_t start = ++pos;
+    while (pos < line.size() && line[pos] != '"' && line[pos] != '\\') {
+        ++pos;
+    }
+    if (pos >= line.size()) {
+        return false;
+    }
+    if (line[pos] == '"') {
+        value = line.substr(start, pos - start);
+        ++pos;
+        return true;
+    }
+    scratch.assign(line.data() + start, pos - start);
+    while (pos < line.size()) {
+        char c = line[pos++];
+        if (c == '"') {
+            value = scratch;
+            return true;
+        }
+        if (c != '\\') {
+            scratch.push_back(c);
+            continue;
+        }
+        if (pos >= line.size()) {
+            return false;
+        }
+        char escape = line[pos++];
+        switch (escape) {
+            case '"': scratch.push_back('"'); break;
+            case '\\': scratch.push_back('\\'); break;
+            case '/': scratch.push_back('/'); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u': {
+                std::uint32_t code;
+                if (!hex4(line, pos, code)) {
+                    return false;
+                }
+                pos += 4;
+                if (code >= 0xD800 && code < 0xDC00) {
+                    std::uint32_t low;
+                    if (pos + 6 > line.size() || line[pos] != '\\' || line[pos + 1] != 'u' ||
+                        !hex4(line, pos + 2, low) || low < 0xDC00 || low >= 0xE000) {
+                        return false;
+                    }
+                    pos += 6;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(scratch, code);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+// Read a number or literal (true/false/null) as raw text
+bool jsonScalar(std::string_view line, std::size_t& pos, std::string_view& value) {
+    std::size_t start = pos;
+    while (pos < line.size() && line[pos] != ',' && line[pos] != '}' && line[pos] != ' ' && line[pos] != '\t') {
+        ++pos;
+    }
+    value = line.substr(start, pos - start);
+    return !value.empty() && value[0] != '{' && value[0] != '[' && value[0] != '"';
+}
+
+bool parseJsonLine(std::string_view line, Fields& fields, Scratch& scratch) {
+    std::size_t pos = 0;
+    skipSpace(line, pos);
+    if (pos >= line.size() || line[pos++] != '{') {
+        return false;
+    }
+    std::string keyScratch;
+    skipSpace(line, pos);
+    if (pos < line.size() && line[pos] == '}') {
+        ++pos;
+    } else {
+        for (;;) {
+            std::string_view key;
+            skipSpace(line, pos);
+            if (!jsonString(line, pos, key, keyScratch)) {
+                return false;
+            }
+            skipSpace(line, pos);
+            if (pos >= line.size() || line[pos++] != ':') {
+                return false;
+            }
+            skipSpace(line, pos);
+
+            std::string_view* slot = nullptr;
+            bool* present = nullptr;
+            std::string* buffer = &keyScratch;
+            if (key == "name") {
+                slot = &fields.name, present = &fields.hasName, buffer = &scratch.buffers[0];
+            } else if (key == "kind") {
+                slot = &fields.kind, present = &fields.hasKind, buffer = &scratch.buffers[1];
+            } else if (key == "priority") {
+                slot = &fields.priority, present = &fields.hasPriority, buffer = &scratch.buffers[2];
+            } else if (key == "estimatedTime") {
+                slot = &fields.estimatedTime, present = &fields.hasEstimatedTime, buffer = &scratch.buffers[3];
+            } else if (key == "deadline") {
+                slot = &fields.deadline, buffer = &scratch.buffers[4];
+            } else if (key == "owner") {
+                slot = &fields.owner, present = &fields.hasOwner, buffer = &scratch.buffers[5];
+            }
+
+            std::string_view value;
+            bool isString = pos < line.size() && line[pos] == '"';
+            if (isString ? !jsonString(line, pos, value, *buffer) : !jsonScalar(line, pos, value)) {
+                return false;
+            }
+            if (slot != nullptr) {
+                *slot = value;
+                if (present != nullptr) {
+                    *present = true;
+                }
+            }
+
+            skipSpace(line, pos);
+            if (pos >= line.size()) {
+                return false;
+            }
+            char c = line[pos++];
+            if (c == '}') {
+                break;
+            }
+            if (c != ',') {
+                return false;
+            }
+        }
+    }
+    skipSpace(line, pos);
+    return pos == line.size();
+}
+
+bool buildTask(const Fields& fields, Task& task) {
+    if (!fields.hasName || !fields.hasKind || !fields.hasPriority || !fields.hasEstimatedTime ||
+        !fields.hasOwner || fields.name.empty() || fields.owner.empty()) {
+        return false;
+    }
+    if (!TaskImporter::parseKind(fields.kind, task.kind) || !parseInt(fields.priority, task.priority) ||
+        !parseInt(fields.estimatedTime, task.estimatedTime)) {
+        return false;
+    }
+    if (task.priority < 1 || task.priority > 3 || task.estimatedTime < 0) {
+        return false;
+    }
+    task.deadline = std::chrono::system_clock::time_point();
+    std::string_view deadline = trim(fields.deadline);
+    if (!deadline.empty() && !TaskImporter::parseDeadline(deadline, task.deadline)) {
+        return false;
+    }
+    task.name.assign(fields.name.data(), fields.name.size());
+    task.isCompleted = false;
+    return true;
+}
+
+}
+
+void ParsedChunk::clear() {
+    owners.clear();
+    tasks.clear();
+    lines = 0;
+    rejected = 0;
+    firstRejectedLine = 0;
+}
+
+bool TaskImporter::parseKind(std::string_view text, TaskKind& kind) {
+    static const char* const names[TaskKindCount] = {"ai", "hpc", "programming", "devops"};
+    text = trim(text);
+    for (int k = 0; k < TaskKindCount; ++k) {
+        if (equalsLower(text, names[k])) {
+            kind = static_cast<TaskKind>(k);
+            return true;
+        }
+    }
+    int number;
+    if (parseInt(text, number) && number >= 0 && number < TaskKindCount) {
+        kind = static_cast<TaskKind>(number);
+        return true;
+    }
+    return false;
+}
+
+bool TaskImporter::parseDeadline(std::string_view text, std::chrono::system_clock::time_point& deadline) {
+    int year, month, day;
+    if (!parseDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' || text[7] != '-' ||
+        !parseDigits(text, 5, 2, month) || !parseDigits(text, 8, 2, day) ||
+        month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    int hour = 0, minute = 0, second = 0;
+    long long nanoseconds = 0;
+    int offsetMinutes = 0;
+    std::size_t pos = 10;
+    if (pos < text.size() && (text[pos] == 'T' || text[pos] == 't' || text[pos] == ' ')) {
+        if (!parseDigits(text, pos + 1, 2, hour) || pos + 3 >= text.size() || text[pos + 3] != ':' ||
+            !parseDigits(text, pos + 4, 2, minute)) {
+            return false;
+        }
+        pos += 6;
+        if (pos < text.size() && text[pos] == ':') {
+            if (!parseDigits(text, pos + 1, 2, second)) {
+                return false;
+            }
+            pos += 3;
+            if (pos < text.size() && (text[pos] == '.' || text[pos] == ',')) {
+                long long scale = 100000000;
+                std::size_t digits = 0;
+                for (++pos; pos < text.size() && text[pos] >= '0' && text[pos] <= '9'; ++pos, ++digits) {
+                    nanoseconds += (text[pos] - '0') * scale;
+                    scale /= 10;
+                }
+                if (digits == 0) {
+                    return false;
+                }
+            }
+        }
+        if (hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+        if (pos < text.size()) {
+            if (text[pos] == 'Z' || text[pos] == 'z') {
+                ++pos;
+            } else if (text[pos] == '+' || text[pos] == '-') {
+                int sign = text[pos] == '-' ? -1 : 1;
+                int offsetHours, offsetMins;
+                if (!parseDigits(text, pos + 1, 2, offsetHours)) {
+                    return false;
+                }
+                std::size_t minutesAt = pos + 3 < text.size() && text[pos + 3] == ':' ? pos + 4 : pos + 3;
+                if (!parseDigits(text, minutesAt, 2, offsetMins) || offsetHours > 23 || offsetMins > 59) {
+                    return false;
+                }
+                offsetMinutes = sign * (offsetHours * 60 + offsetMins);
+                pos = minutesAt + 2;
+            }
+        }
+    }
+    if (pos != text.size()) {
+        return false;
+    }
+
+    long long seconds = daysFromCivil(year, month, day) * 86400LL + hour * 3600LL + minute * 60LL + second -
+                        offsetMinutes * 60LL;
+    auto sinceEpoch = std::chrono::seconds(seconds) + std::chrono::nanoseconds(nanoseconds);
+    deadline = std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch));
+    return true;
+}
+
+void TaskImporter::parseChunk(std::string_view text, ImportFormat format, bool atStart, ParsedChunk& out) {
+    out.clear();
+    std::deque<std::string> ownerKeys;  // Stable storage behind the ownerIndex keys
+    std::unordered_map<std::string_view, std::uint32_t> ownerIndex;
+    std::uint32_t lastOwner = NoOwner;  // Exports tend to group tasks by owner
+    Scratch scratch;
+    Task task;
+
+    // Tasks in input order and the owner group of each, reused across chunks
+    thread_local std::vector<Task> parsed;
+    thread_local std::vector<std::uint32_t> ownerOf;
+    parsed.clear();
+    ownerOf.clear();
+
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        const void* found = std::memchr(text.data() + pos, '\n', text.size() - pos);
+        std::size_t end = found != nullptr ? static_cast<const char*>(found) - text.data() : text.size();
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+        ++out.lines;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (trim(line).empty()) {
+            continue;
+        }
+        if (atStart && out.lines == 1 && format == ImportFormat::Csv && line.substr(0, 5) == "name,") {
+            continue; // Header
+        }
+
+        Fields fields;
+        bool ok = format == ImportFormat::Csv ? parseCsvLine(line, fields, scratch)
+                                              : parseJsonLine(line, fields, scratch);
+        if (!ok || !buildTask(fields, task)) {
+            if (out.firstRejectedLine == 0) {
+                out.firstRejectedLine = out.lines;
+            }
+            ++out.rejected;
+            continue;
+        }
+
+        std::string_view owner = fields.owner;
+        if (lastOwner == NoOwner || out.owners[lastOwner] != owner) {
+            auto it = ownerIndex.find(owner);
+            if (it == ownerIndex.end()) {
+                ownerKeys.emplace_back(owner);
+                it = ownerIndex.emplace(ownerKeys.back(), static_cast<std::uint32_t>(out.owners.size())).first;
+                out.owners.emplace_back(owner);
+                out.tasks.emplace_back();
+            }
+            lastOwner = it->second;
+        }
+        parsed.push_back(std::move(task));
+        ownerOf.push_back(lastOwner);
+    }
+
+    // Hand the tasks to their owners' groups, each sized exactly once
+    std::vector<std::size_t> counts(out.owners.size(), 0);
+    for (std::uint32_t owner : ownerOf) {
+        ++counts[owner];
+    }
+    for (std::size_t owner = 0; owner < counts.size(); ++owner) {
+        out.tasks[owner].reserve(counts[owner]);
+    }
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        out.tasks[ownerOf[i]].push_back(std::move(parsed[i]));
+    }
+}
+
+void TaskImporter::merge(ParsedChunk& chunk, UserManager& users, ImportResult& result) {
+    for (std::size_t i = 0; i < chunk.owners.size(); ++i) {
+        const std::string& owner = chunk.owners[i];
+        std::vector<Task>& batch = chunk.tasks[i];
+        std::shared_ptr<User> user = users.findUser(owner);
+        // Never create an account anyone can log into without a password
+        if (!user && options.createUsers && !options.defaultPassword.empty() &&
+            users.registerUser(owner, options.defaultPassword)) {
+            user = users.findUser(owner);
+        }
+        if (!user) {
+            result.rejected += batch.size();
+            continue;
+        }
+        users.withUser(user, [&](User& locked) {
+            locked.addTasks(batch);
+        });
+        result.imported += batch.size();
+    }
+    if (chunk.firstRejectedLine != 0 && result.firstRejectedLine == 0) {
+        result.firstRejectedLine = result.lines + chunk.firstRejectedLine;
+    }
+    result.rejected += chunk.rejected;
+    result.lines += chunk.lines;
+}
+
+template <typename NextWindow>
+ImportResult TaskImporter::run(NextWindow nextWindow, UserManager& users) {
+    ImportResult result;
+    std::size_t chunkBytes = std::max<std::size_t>(options.chunkBytes, 1);
+    std::size_t chunksPerWindow = options.chunksPerWindow != 0
+        ? options.chunksPerWindow
+        : 4 * std::max<std::size_t>(pool.threadCount(), 1);
+
+    std::vector<ParsedChunk> parsing;  // Window being parsed on the pool
+    std::vector<ParsedChunk> merging;  // Previous window, merged meanwhile
+    std::vector<std::string_view> pieces;
+    bool atStart = true;
+    for (;;) {
+        std::string_view window = nextWindow(chunkBytes * chunksPerWindow);
+
+        // Cut the window into chunks that end on a line boundary
+        pieces.clear();
+        for (std::size_t start = 0; start < window.size();) {
+            std::size_t end = std::min(start + chunkBytes, window.size());
+            if (end < window.size()) {
+                const void* found = std::memchr(window.data() + end, '\n', window.size() - end);
+                end = found != nullptr ? static_cast<const char*>(found) - window.data() + 1 : window.size();
+            }
+            pieces.push_back(window.substr(start, end - start));
+            start = end;
+        }
+
+        parsing.resize(pieces.size());
+        std::vector<WorkStealingPool::Job> jobs;
+        jobs.reserve(pieces.size());
+        for (std::size_t i = 0; i < pieces.size(); ++i) {
+            bool first = atStart && i == 0;
+            jobs.push_back([this, &pieces, &parsing, i, first] {
+                parseChunk(pieces[i], options.format, first, parsing[i]);
+            });
+        }
+        pool.submitBatch(std::move(jobs));
+
+        for (ParsedChunk& chunk : merging) {
+            merge(chunk, users, result);
+        }
+        pool.wait();
+
+        result.bytes += window.size();
+        atStart = false;
+        std::swap(parsing, merging);
+        if (window.empty()) {
+            break;
+        }
+    }
+    return result;
+}
+
+ImportResult TaskImporter::importText(std::string_view text, UserManager& users) {
+    std::size_t offset = 0;
+    return run([&](std::size_t bytes) {
+        std::size_t start = offset;
+        std::size_t end = std::min(start + bytes, text.size());
+        if (end < text.size()) {
+            const void* found = std::memchr(text.data() + end, '\n', text.size() - end);
+            end = found != nullptr ? static_cast<const char*>(found) - text.data() + 1 : text.size();
+        }
+        offset = end;
+        return text.substr(start, end - start);
+    }, users);
+}
+
+bool TaskImporter::importFile(const std::string& path, UserManager& users, ImportResult& result) {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+    if (!file) {
+        return false;
+    }
+    // Allocated once at window size and left uninitialized; it only grows
+    // when a single line is longer than the room left for it
+    std::unique_ptr<char[]> buffer;
+    std::size_t capacity = 0;
+    std::size_t filled = 0;    // Bytes held in buffer
+    std::size_t consumed = 0;  // Prefix handed out as the previous window
+    bool atEnd = false;
+    bool failed = false;
+
+    result = run([&](std::size_t bytes) {
+        // Keep the partial line left over from the previous window
+        if (consumed > 0) {
+            std::memmove(buffer.get(), buffer.get() + consumed, filled - consumed);
+            filled -= consumed;
+            consumed = 0;
+        }
+        while (!atEnd) {
+            if (filled + bytes > capacity) {
+                capacity = std::max(filled + bytes, capacity * 2);
+                std::unique_ptr<char[]> larger(new char[capacity]);
+                if (filled > 0) {
+                    std::memcpy(larger.get(), buffer.get(), filled);
+                }
+                buffer = std::move(larger);
+            }
+            std::size_t read = std::fread(buffer.get() + filled, 1, bytes, file.get());
+            std::size_t scanFrom = filled;  // Earlier bytes hold no line end
+            filled += read;
+            if (read < bytes) {
+                atEnd = true;
+                failed = std::ferror(file.get()) != 0;
+                break;
+            }
+            // Stop after the last complete line; read more if there is none yet
+            for (std::size_t i = filled; i > scanFrom; --i) {
+                if (buffer[i - 1] == '\n') {
+                    consumed = i;
+                    return std::string_view(buffer.get(), consumed);
+                }
+            }
+        }
+        consumed = filled;
+        return std::string_view(buffer.get(), consumed);
+    }, users);
+    return !failed;
+}
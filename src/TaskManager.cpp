@@ -1,52 +1,284 @@
 #include "TaskManager.h"
+#include "OpStats.h"
+#include "TaskRenderer.h"
+#include "TaskReports.h"
+#include "WorkStealingPool.h"
 #include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <utility>
 
-void TaskManager::addTask(std::unique_ptr<BaseTask> task) {
-    tasks.push_back(std::move(task));
+namespace {
+
+template <typename Store, typename Predicate>
+std::vector<TaskId> selectTasks(const Store& store, Predicate predicate) {
+    std::vector<TaskId> selected;
+    store.forEach([&](TaskId id) {
+        if (predicate(id)) {
+            selected.push_back(id);
+        }
+    });
+    return selected;
 }
 
-void TaskManager::displayTasks() const {
-    for (const auto& task : tasks) {
-        task->displayTask();
+}
+
+TaskId TaskManager::addTask(std::unique_ptr<BaseTask> task) {
+    OpTimer timer(Operation::AddTask);
+    if (mapped) {
+        return TaskStore::npos;
     }
+    TaskId id = store.add(*task);
+    order.push_back(id);
+    priorityIndex.insert(PriorityIndex::keyOf(store, id), store.isCompleted(id));
+    graph.addTask(id, store.estimatedTime(id), store.isCompleted(id));
+    return id;
 }
 
-void TaskManager::prioritizeTasks() {
-    std::sort(tasks.begin(), tasks.end(), [](const std::unique_ptr<BaseTask>& t1, const std::unique_ptr<BaseTask>& t2) {
-        return t1->getPriority() > t2->getPriority(); // Sort in descending order of priority
-    });
+TaskId TaskManager::addTask(const Task& task) {
+    OpTimer timer(Operation::AddTask);
+    if (mapped) {
+        return TaskStore::npos;
+    }
+    TaskId id = store.add(task);
+    order.push_back(id);
+    priorityIndex.insert(PriorityIndex::keyOf(store, id), store.isCompleted(id));
+    graph.addTask(id, store.estimatedTime(id), store.isCompleted(id));
+    return id;
 }
 
-// New function to display tasks by priority (High -> Low)
-void TaskManager::displayTasksByPriority() const {
-    std::cout << "\nHigh Priority Tasks (Priority 3):\n";
-    for (const auto& task : tasks) {
-        if (task->getPriority() == 3) {
-            task->displayTask();
+TaskId TaskManager::addTasks(const Task* tasks, std::size_t count) {
+    OpTimer timer(Operation::AddTask);
+    if (mapped || count == 0) {
+        return TaskStore::npos;
+    }
+    TaskId first = static_cast<TaskId>(store.capacity());
+    store.reserve(first + count);
+    if (order.size() + count > order.capacity()) {
+        order.reserve(std::max(order.size() + count, order.capacity() * 2));
+    }
+    graph.reserve(first + count);
+    for (std::size_t i = 0; i < count; ++i) {
+        TaskId id = store.add(tasks[i]);
+        order.push_back(id);
+        graph.addTask(id, store.estimatedTime(id), store.isCompleted(id));
+    }
+    priorityIndex.insertBatch(store, first, static_cast<TaskId>(first + count));
+    return first;
+}
+
+TaskId TaskManager::addTask(const Task& task, std::function<void()> payload) {
+    TaskId id = addTask(task);
+    if (id != TaskStore::npos && payload) {
+        if (payloads.size() <= id) {
+            payloads.resize(id + 1);
         }
+        payloads[id] = std::move(payload);
+    }
+    return id;
+}
+
+std::size_t TaskManager::run(WorkStealingPool& pool) {
+    if (mapped) {
+        return 0;
     }
+    // Workers only write their own task's byte; the graph is shared behind a
+    // mutex, and the store and priority index are updated after wait().
+    std::vector<char> succeeded(store.capacity(), 0);
+    std::mutex graphMutex;
+    auto runnable = [this](TaskId id) { return id < payloads.size() && payloads[id]; };
 
-    std::cout << "\nMedium Priority Tasks (Priority 2):\n";
-    for (const auto& task : tasks) {
-        if (task->getPriority() == 2) {
-            task->displayTask();
+    std::function<void(TaskId)> execute = [&](TaskId id) {
+        try {
+            payloads[id]();
+        } catch (...) {
+            return; // Leave the task and its dependents incomplete
+        }
+        succeeded[id] = 1;
+        std::vector<TaskId> released;
+        {
+            std::lock_guard<std::mutex> lock(graphMutex);
+            graph.markComplete(id, &released);
+        }
+        for (TaskId next : released) {
+            if (runnable(next)) {
+                pool.submit([&execute, next] { execute(next); });
+            }
+        }
+    };
+
+    // Jobs are built in priority order so each worker's deque is too
+    std::vector<WorkStealingPool::Job> jobs;
+    priorityIndex.forEachOpen([&](TaskId id) {
+        if (runnable(id) && graph.isReady(id)) {
+            jobs.emplace_back([&execute, id] { execute(id); });
+        }
+        return true;
+    });
+    pool.submitBatch(std::move(jobs));
+    pool.wait();
+
+    std::size_t completed = 0;
+    for (TaskId id = 0; id < succeeded.size(); ++id) {
+        if (succeeded[id]) {
+            priorityIndex.markComplete(PriorityIndex::keyOf(store, id));
+            store.markComplete(id);
+            payloads[id] = nullptr;
+            ++completed;
         }
     }
+    return completed;
+}
+
+std::size_t TaskManager::run() {
+    WorkStealingPool pool;
+    return run(pool);
+}
 
-    std::cout << "\nLow Priority Tasks (Priority 1):\n";
-    for (const auto& task : tasks) {
-        if (task->getPriority() == 1) {
-            task->displayTask();
+void TaskManager::displayTasks() const {
+    displayTasks(std::cout);
+}
+
+void TaskManager::displayTasks(std::ostream& out) const {
+    OpTimer timer(Operation::ListTasks);
+    TaskRenderer& renderer = TaskRenderer::local();
+    if (mapped) {
+        reports::renderAll(*mapped, renderer);
+        renderer.flushTo(out);
+        return;
+    }
+    for (TaskId id : order) {
+        if (store.contains(id)) {
+            renderer.appendTask(store, id);
         }
     }
+    renderer.flushTo(out);
+}
+
+void TaskManager::prioritizeTasks() {
+    // The index is already in order, so this is a copy rather than a sort
+    order = priorityIndex.sorted();
+    removedInOrder = 0;
+}
+
+// New function to display tasks by priority (High -> Low)
+void TaskManager::displayTasksByPriority() const {
+    displayTasksByPriority(std::cout);
+}
+
+void TaskManager::displayTasksByPriority(std::ostream& out) const {
+    OpTimer timer(Operation::ListTasks);
+    TaskRenderer& renderer = TaskRenderer::local();
+    if (mapped) {
+        reports::renderByPriority(*mapped, renderer);
+    } else {
+        reports::renderByPriority(store, renderer);
+    }
+    renderer.flushTo(out);
 }
 
 bool TaskManager::markTaskComplete(const std::string& taskName) {
-    for (auto& task : tasks) {
-        if (task->getName() == taskName) {
-            task->markAsComplete();
-            return true;
-        }
+    OpTimer timer(Operation::CompleteTask);
+    if (mapped) {
+        return false;
+    }
+    TaskId id = store.findByName(taskName);
+    if (id == TaskStore::npos) {
+        return false;
+    }
+    priorityIndex.markComplete(PriorityIndex::keyOf(store, id));
+    store.markComplete(id);
+    graph.markComplete(id);
+    return true;
+}
+
+bool TaskManager::addDependency(TaskId task, TaskId prerequisite) {
+    if (mapped) {
+        return false;
+    }
+    return graph.addDependency(task, prerequisite);
+}
+
+bool TaskManager::removeTask(const std::string& taskName) {
+    if (mapped) {
+        return false;
+    }
+    TaskId id = store.findByName(taskName);
+    if (id == TaskStore::npos) {
+        return false;
+    }
+    priorityIndex.erase(PriorityIndex::keyOf(store, id), store.isCompleted(id));
+    store.remove(id);
+    // Left in 'order' and skipped when displayed, so removal never searches it
+    if (++removedInOrder * 2 > order.size()) {
+        order.erase(std::remove_if(order.begin(), order.end(), [this](TaskId task) { return !store.contains(task); }),
+                    order.end());
+        removedInOrder = 0;
+    }
+    if (id < payloads.size()) {
+        payloads[id] = nullptr;
+    }
+    graph.removeTask(id);
+    return true;
+}
+
+bool TaskManager::updateTask(const std::string& taskName, int priority, std::chrono::system_clock::time_point deadline) {
+    if (mapped) {
+        return false;
+    }
+    TaskId id = store.findByName(taskName);
+    if (id == TaskStore::npos) {
+        return false;
+    }
+    PriorityIndex::Key before = PriorityIndex::keyOf(store, id);
+    store.setPriority(id, priority);
+    store.setDeadline(id, deadline);
+    priorityIndex.update(before, PriorityIndex::keyOf(store, id), store.isCompleted(id));
+    return true;
+}
+
+bool TaskManager::saveReadOnly(const std::string& path) const {
+    return MappedTaskStore::write(store, path);
+}
+
+bool TaskManager::openReadOnly(const std::string& path) {
+    auto file = std::make_unique<MappedTaskStore>();
+    if (!file->open(path)) {
+        return false;
+    }
+    mapped = std::move(file);
+    store = TaskStore();
+    order.clear();
+    removedInOrder = 0;
+    priorityIndex.clear();
+    payloads.clear();
+    graph = TaskGraph();
+    return true;
+}
+
+std::size_t TaskManager::taskCount() const {
+    return mapped ? mapped->size() : store.size();
+}
+
+std::vector<TaskId> TaskManager::tasksWithPriority(int priority) const {
+    if (mapped) {
+        return selectTasks(*mapped, [&](TaskId id) { return mapped->priority(id) == priority; });
+    }
+    const std::vector<int>& priorities = store.priorityColumn();
+    return selectTasks(store, [&](TaskId id) { return priorities[id] == priority; });
+}
+
+std::vector<TaskId> TaskManager::overdueTasks(std::chrono::system_clock::time_point now) const {
+    if (mapped) {
+        return selectTasks(*mapped, [&](TaskId id) { return now > mapped->deadline(id); });
+    }
+    const auto& deadlines = store.deadlineColumn();
+    return selectTasks(store, [&](TaskId id) { return now > deadlines[id]; });
+}
+
+std::vector<TaskHandle> TaskManager::nextTasks(std::size_t k, const TaskFilter& filter, const TaskScoring& scoring) const {
+    if (mapped) {
+        return query::nextTasks(*mapped, nullptr, k, filter, scoring);
     }
-    return false;
+    return query::nextTasks(store, &priorityIndex, k, filter, scoring);
 }
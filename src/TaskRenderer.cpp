@@ -0,0 +1,42 @@
+#include "TaskRenderer.h"
+#include <charconv>
+#include <cstdint>
+
+const char* TaskRenderer::formatDeadline(std::time_t time) {
+    // Fibonacci hashing spreads regularly spaced deadlines (whole hours, days) across the cache
+    std::uint64_t slot = (static_cast<std::uint64_t>(time) * 0x9E3779B97F4A7C15ULL) >> 52;
+    CachedDeadline& entry = deadlineCache[slot];
+    if (!entry.valid || entry.time != time) {
+        char formatted[26]; // Buffer to hold formatted time
+        ctime_r(&time, formatted); // Thread-safe version of ctime
+        std::char_traits<char>::copy(entry.text, formatted, 24);
+        entry.time = time;
+        entry.valid = true;
+    }
+    return entry.text;
+}
+
+void TaskRenderer::appendInt(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void TaskRenderer::flushTo(std::ostream& out) {
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    reset();
+}
+
+void TaskRenderer::reset() {
+    if (buffer.capacity() > RetainedCapacity) {
+        std::string().swap(buffer);
+    } else {
+        buffer.clear();
+    }
+}
+
+TaskRenderer& TaskRenderer::local() {
+    thread_local TaskRenderer renderer;
+    return renderer;
+}
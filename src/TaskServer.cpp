@@ -0,0 +1,495 @@
+#include "TaskServer.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+#include "OpStats.h"
+#include "Task.h"
+#include "UserManager.h"
+
+namespace {
+
+constexpr int MaxEvents = 256;
+constexpr std::size_t ReadBytes = 64 * 1024;
+
+using Nanoseconds = std::chrono::duration<std::int64_t, std::nano>;
+
+// Encoded size of a ListTasks entry, not counting the name's bytes
+constexpr std::size_t ListEntryBytes = 4 + 1 + 4 + 4 + 4 + 8 + 1;
+
+}
+
+TaskServer::TaskServer(UserManager& userManager) : users(userManager) {
+    epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd >= 0 && wakeFd >= 0) {
+        watch(wakeFd);
+    }
+}
+
+TaskServer::~TaskServer() {
+    while (!connections.empty()) {
+        close(connections.begin()->first);
+    }
+    for (int fd : {unixFd, tcpFd, wakeFd, epollFd}) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    if (!unixPath.empty()) {
+        ::unlink(unixPath.c_str());
+    }
+}
+
+bool TaskServer::watch(int fd) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    return ::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool TaskServer::listenUnix(const std::string& path) {
+    sockaddr_un address{};
+    if (epollFd < 0 || unixFd >= 0 || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    // Only a socket left behind by an earlier run is replaced; any other
+    // file at 'path' (say, a snapshot named by mistake) is left alone
+    struct stat existing;
+    if (::lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode) || ::unlink(path.c_str()) != 0) {
+            return false;
+        }
+    }
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0 || !watch(fd)) {
+        ::close(fd);
+        return false;
+    }
+    unixFd = fd;
+    unixPath = path;
+    return true;
+}
+
+bool TaskServer::listenTcp(int port) {
+    if (epollFd < 0 || tcpFd >= 0) {
+        return false;
+    }
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int enable = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<std::uint16_t>(port));
+    socklen_t length = sizeof(address);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0 || !watch(fd)) {
+        ::close(fd);
+        return false;
+    }
+    tcpFd = fd;
+    tcpPort = ntohs(address.sin_port);
+    return true;
+}
+
+void TaskServer::stop() {
+    stopping.store(true);
+    std::uint64_t one = 1;
+    ssize_t written = ::write(wakeFd, &one, sizeof(one));
+    (void)written;
+}
+
+bool TaskServer::run() {
+    if (epollFd < 0 || wakeFd < 0 || (unixFd < 0 && tcpFd < 0)) {
+        return false;
+    }
+    epoll_event events[MaxEvents];
+    std::vector<int> dirty;
+    while (!stopping.load()) {
+        int count = ::epoll_wait(epollFd, events, MaxEvents, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        // Execute everything that arrived this round
+        for (int i = 0; i < count; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == wakeFd) {
+                std::uint64_t value;
+                ssize_t drained = ::read(wakeFd, &value, sizeof(value));
+                (void)drained;
+                continue;
+            }
+            if (fd == unixFd || fd == tcpFd) {
+                accept(fd);
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            bool ok = true;
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                ok = (events[i].events & EPOLLIN) != 0;
+            }
+            if (ok && (events[i].events & EPOLLIN)) {
+                ok = readFrom(connection);
+            }
+            if (!ok) {
+                close(fd);
+                continue;
+            }
+            if (!connection.dirty) {
+                connection.dirty = true;
+                dirty.push_back(fd);
+            }
+        }
+
+        // One log sync covers every mutation of the round, and it happens
+        // before any client is told its change succeeded
+        if (mutated) {
+            users.syncLog();
+            mutated = false;
+        }
+
+        for (int fd : dirty) {
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = *it->second;
+            connection.dirty = false;
+            bool ok = flush(connection);
+            // Requests held back while output was backed up can run now
+            if (ok && connection.readPaused && connection.output.size() - connection.outputOffset < MaxPendingOutput) {
+                connection.readPaused = false;
+                ok = processInput(connection);
+                if (mutated) {
+                    users.syncLog();
+                    mutated = false;
+                }
+                ok = ok && flush(connection);
+            }
+            bool drained = connection.outputOffset == connection.output.size();
+            if (!ok || (connection.peerClosed && drained)) {
+                close(fd);
+                continue;
+            }
+            updateInterest(connection);
+        }
+        dirty.clear();
+    }
+    stopping.store(false);
+    return true;
+}
+
+void TaskServer::accept(int listenFd) {
+    for (;;) {
+        int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty; other errors drop just this client
+        }
+        if (listenFd == tcpFd) {
+            int enable = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        if (!watch(fd)) {
+            ::close(fd);
+            continue;
+        }
+        connections.emplace(fd, std::move(connection));
+    }
+}
+
+void TaskServer::close(int fd) {
+    ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    auto it = connections.find(fd);
+    if (it != connections.end()) {
+        users.closeSession(it->second->session);
+        connections.erase(it);
+    }
+}
+
+bool TaskServer::readFrom(Connection& connection) {
+    if (connection.readPaused || connection.peerClosed) {
+        return true;
+    }
+    for (;;) {
+        std::size_t used = connection.input.size();
+        connection.input.resize(used + ReadBytes);
+        ssize_t received = ::recv(connection.fd, &connection.input[used], ReadBytes, 0);
+        connection.input.resize(used + (received > 0 ? static_cast<std::size_t>(received) : 0));
+        if (received > 0) {
+            if (static_cast<std::size_t>(received) < ReadBytes) {
+                break; // Drained the socket for now
+            }
+            continue;
+        }
+        if (received == 0) {
+            connection.peerClosed = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+    return processInput(connection);
+}
+
+bool TaskServer::processInput(Connection& connection) {
+    std::string& input = connection.input;
+    for (;;) {
+        if (connection.output.size() - connection.outputOffset >= MaxPendingOutput) {
+            connection.readPaused = true;
+            break;
+        }
+        std::string_view body;
+        std::size_t frameBytes = 0;
+        protocol::FrameState state = protocol::nextFrame(input.data() + connection.inputOffset,
+                                                         input.size() - connection.inputOffset, body, frameBytes);
+        if (state == protocol::FrameState::TooLarge) {
+            return false;
+        }
+        if (state == protocol::FrameState::Incomplete) {
+            break;
+        }
+        handle(connection, body);
+        connection.inputOffset += frameBytes;
+    }
+    // Keep only the unparsed tail
+    if (connection.inputOffset > 0) {
+        input.erase(0, connection.inputOffset);
+        connection.inputOffset = 0;
+    }
+    return true;
+}
+
+bool TaskServer::flush(Connection& connection) {
+    std::string& output = connection.output;
+    while (connection.outputOffset < output.size()) {
+        ssize_t sent = ::send(connection.fd, output.data() + connection.outputOffset,
+                              output.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outputOffset += static_cast<std::size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true; // The rest goes out when EPOLLOUT fires
+        }
+        return false;
+    }
+    output.clear();
+    connection.outputOffset = 0;
+    return true;
+}
+
+void TaskServer::updateInterest(Connection& connection) {
+    std::uint32_t wanted = 0;
+    if (!connection.readPaused && !connection.peerClosed) {
+        wanted |= EPOLLIN;
+    }
+    if (connection.outputOffset < connection.output.size()) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == connection.events) {
+        return;
+    }
+    epoll_event event{};
+    event.events = wanted;
+    event.data.fd = connection.fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.events = wanted;
+}
+
+void TaskServer::handle(Connection& connection, std::string_view request) {
+    requests.fetch_add(1, std::memory_order_relaxed);
+    binio::Reader reader(request.data(), request.size());
+    std::uint32_t requestId = reader.get<std::uint32_t>();
+    auto opcode = static_cast<protocol::Opcode>(reader.get<std::uint8_t>());
+
+    std::string& out = connection.output;
+    std::size_t frame = protocol::beginFrame(out);
+    binio::Writer writer(out);
+    writer.put(requestId);
+    std::size_t statusAt = out.size();
+    writer.put(static_cast<std::uint8_t>(protocol::Status::Ok));
+
+    protocol::Status status = reader.ok() ? execute(connection, opcode, reader, out) : protocol::Status::BadRequest;
+    if (status != protocol::Status::Ok) {
+        out.resize(statusAt + 1); // Drop any partial result
+        out[statusAt] = static_cast<char>(status);
+    }
+    protocol::endFrame(out, frame);
+}
+
+protocol::Status TaskServer::execute(Connection& connection, protocol::Opcode opcode, binio::Reader& reader,
+                                     std::string& out) {
+    using protocol::Opcode;
+    using protocol::Status;
+    binio::Writer writer(out);
+
+    switch (opcode) {
+        case Opcode::Register:
+        case Opcode::Login: {
+            std::string_view username = reader.getString();
+            std::string password(reader.getString());
+            if (!reader.ok() || !reader.atEnd() || username.empty() || password.empty()) {
+                return Status::BadRequest;
+            }
+            if (opcode == Opcode::Register) {
+                if (!users.registerUser(username, password)) {
+                    return Status::AlreadyExists;
+                }
+                mutated = true;
+                return Status::Ok;
+            }
+            SessionToken session = users.openSession(username, password);
+            if (session == SessionTable::NoSession) {
+                return Status::AuthFailed;
+            }
+            users.closeSession(connection.session);
+            connection.session = session;
+            return Status::Ok;
+        }
+
+        case Opcode::Logout:
+            if (!reader.atEnd()) {
+                return Status::BadRequest;
+            }
+            users.closeSession(connection.session);
+            connection.session = SessionTable::NoSession;
+            return Status::Ok;
+
+        case Opcode::AddTask: {
+            std::uint8_t kind = reader.get<std::uint8_t>();
+            std::string_view name = reader.getString();
+            std::int32_t priority = reader.get<std::int32_t>();
+            std::int32_t estimatedTime = reader.get<std::int32_t>();
+            std::int64_t deadline = reader.get<std::int64_t>();
+            // Same limits as BatchRunner and TaskImporter
+            if (!reader.ok() || !reader.atEnd() || kind >= TaskKindCount || name.empty() || priority < 1 ||
+                priority > 3 || estimatedTime < 0) {
+                return Status::BadRequest;
+            }
+            Task task(static_cast<TaskKind>(kind), std::string(name), priority, estimatedTime,
+                      std::chrono::system_clock::time_point(
+                          std::chrono::duration_cast<std::chrono::system_clock::duration>(Nanoseconds(deadline))));
+            TaskId id = 0;
+            if (!users.withSession(connection.session, [&](User& user) { id = user.addTask(task); })) {
+                return Status::NotLoggedIn;
+            }
+            mutated = true;
+            writer.put(static_cast<std::uint32_t>(id));
+            return Status::Ok;
+        }
+
+        case Opcode::MarkTaskComplete: {
+            std::string name(reader.getString());
+            if (!reader.ok() || !reader.atEnd()) {
+                return Status::BadRequest;
+            }
+            bool found = false;
+            if (!users.withSession(connection.session, [&](User& user) { found = user.markTaskComplete(name); })) {
+                return Status::NotLoggedIn;
+            }
+            if (!found) {
+                return Status::NotFound;
+            }
+            mutated = true;
+            return Status::Ok;
+        }
+
+        case Opcode::ListTasks: {
+            std::uint32_t limit = reader.get<std::uint32_t>();
+            std::uint8_t resume = reader.get<std::uint8_t>();
+            PriorityIndex::Key after{};
+            if (resume == 1) {
+                after.priority = reader.get<std::int32_t>();
+                after.deadline = PriorityIndex::TimePoint(std::chrono::duration_cast<PriorityIndex::TimePoint::duration>(
+                    Nanoseconds(reader.get<std::int64_t>())));
+                after.id = reader.get<std::uint32_t>();
+            }
+            if (!reader.ok() || !reader.atEnd() || resume > 1) {
+                return Status::BadRequest;
+            }
+            // The fields follow the 4-byte request ID and the status byte
+            std::size_t resultEnd = out.size() + protocol::MaxFrameBytes - 5;
+            std::uint32_t count = 0;
+            bool more = false;
+            bool tooLarge = false;  // The next task alone overflows a frame
+            bool listed = users.withSession(connection.session, [&](User& user) {
+                OpTimer timer(Operation::ListTasks);
+                const TaskStore& tasks = user.getTasks();
+                writer.put(static_cast<std::uint32_t>(tasks.size()));
+                std::size_t moreAt = out.size();
+                writer.put(static_cast<std::uint8_t>(0));
+                std::size_t countAt = out.size();
+                writer.put(count);
+                user.getPriorityIndex().forEachSortedAfter(resume ? &after : nullptr, [&](TaskId id) {
+                    std::string_view name = tasks.name(id);
+                    if (limit != 0 && count == limit) {
+                        more = true;
+                        return false;
+                    }
+                    if (out.size() + ListEntryBytes + name.size() > resultEnd) {
+                        more = true;
+                        tooLarge = count == 0;
+                        return false;
+                    }
+                    ++count;
+                    writer.put(static_cast<std::uint32_t>(id));
+                    writer.put(static_cast<std::uint8_t>(tasks.kind(id)));
+                    writer.putString(tasks.name(id));
+                    writer.put(static_cast<std::int32_t>(tasks.priority(id)));
+                    writer.put(static_cast<std::int32_t>(tasks.estimatedTime(id)));
+                    writer.put(static_cast<std::int64_t>(
+                        std::chrono::duration_cast<Nanoseconds>(tasks.deadline(id).time_since_epoch()).count()));
+                    writer.put(static_cast<std::uint8_t>(tasks.isCompleted(id) ? 1 : 0));
+                    return true;
+                });
+                writer.putAt(moreAt, static_cast<std::uint8_t>(more ? 1 : 0));
+                writer.putAt(countAt, count);
+            });
+            if (!listed) {
+                return Status::NotLoggedIn;
+            }
+            return tooLarge ? Status::TooLarge : Status::Ok;
+        }
+    }
+    return Status::BadRequest;
+}
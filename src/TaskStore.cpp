@@ -0,0 +1,127 @@
+#include "TaskStore.h"
+#include "TaskRenderer.h"
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+
+void TaskStore::reserve(std::size_t count) {
+    if (count <= kinds.capacity()) {
+        return;
+    }
+    count = std::max(count, kinds.capacity() * 2);
+    nameColumn.reserve(count);
+    nextSameName.reserve(count);
+    priorities.reserve(count);
+    deadlines.reserve(count);
+    estimatedTimes.reserve(count);
+    flags.reserve(count);
+    kinds.reserve(count);
+}
+
+TaskId TaskStore::add(TaskKind kind, std::string_view name, int priority, int estimatedTime,
+                      TimePoint deadline, bool completed) {
+    TaskId id = static_cast<TaskId>(kinds.size());
+    Symbol symbol = names.intern(name);
+
+    nameColumn.push_back(symbol);
+    priorities.push_back(priority);
+    deadlines.push_back(deadline);
+    estimatedTimes.push_back(estimatedTime);
+    flags.push_back(completed ? CompletedFlag : 0);
+    kinds.push_back(kind);
+    nextSameName.push_back(npos);
+
+    if (symbol >= firstByName.size()) {
+        firstByName.resize(symbol + 1, npos);
+        lastByName.resize(symbol + 1, npos);
+    }
+    if (firstByName[symbol] == npos) {
+        firstByName[symbol] = id;
+    } else {
+        nextSameName[lastByName[symbol]] = id;
+    }
+    lastByName[symbol] = id;
+    ++liveCount;
+    return id;
+}
+
+TaskId TaskStore::add(const Task& task) {
+    return add(task.kind, task.name, task.priority, task.estimatedTime, task.deadline, task.isCompleted);
+}
+
+Task TaskStore::get(TaskId id) const {
+    Task task(kinds[id], std::string(name(id)), priorities[id], estimatedTimes[id], deadlines[id]);
+    task.isCompleted = isCompleted(id);
+    return task;
+}
+
+TaskId TaskStore::add(const BaseTask& task) {
+    return add(task.getKind(), task.getName(), task.getPriority(), task.getEstimatedTime(),
+               task.getDeadline(), task.isTaskCompleted());
+}
+
+bool TaskStore::remove(TaskId id) {
+    if (!contains(id)) {
+        return false;
+    }
+    flags[id] |= RemovedFlag;
+    --liveCount;
+
+    // Unlink the task from its name's chain
+    Symbol symbol = nameColumn[id];
+    TaskId previous = npos;
+    if (firstByName[symbol] == id) {
+        firstByName[symbol] = nextSameName[id];
+    } else {
+        previous = firstByName[symbol];
+        while (nextSameName[previous] != id) {
+            previous = nextSameName[previous];
+        }
+        nextSameName[previous] = nextSameName[id];
+    }
+    if (lastByName[symbol] == id) {
+        lastByName[symbol] = previous;
+    }
+    nextSameName[id] = npos;
+    return true;
+}
+
+void TaskStore::rebuildNameIndex() {
+    firstByName.assign(names.size(), npos);
+    lastByName.assign(names.size(), npos);
+    nextSameName.assign(nameColumn.size(), npos);
+    liveCount = 0;
+    for (TaskId id = static_cast<TaskId>(nameColumn.size()); id-- > 0;) {
+        if (!(flags[id] & RemovedFlag)) {
+            Symbol symbol = nameColumn[id];
+            nextSameName[id] = firstByName[symbol];
+            if (lastByName[symbol] == npos) {
+                lastByName[symbol] = id;
+            }
+            firstByName[symbol] = id;
+            ++liveCount;
+        }
+    }
+}
+
+TaskId TaskStore::findByName(std::string_view name) const {
+    Symbol symbol = names.find(name);
+    if (symbol == StringInterner::npos) {
+        return npos;
+    }
+    return firstByName[symbol];
+}
+
+std::string TaskStore::deadlineToString(TaskId id) const {
+    std::time_t deadlineTime = std::chrono::system_clock::to_time_t(deadlines[id]);
+    char buffer[26]; // Buffer to hold formatted time
+    ctime_r(&deadlineTime, buffer); // Thread-safe version of ctime
+    buffer[24] = '\0'; // Remove trailing newline
+    return std::string(buffer);
+}
+
+void TaskStore::displayTask(TaskId id) const {
+    TaskRenderer& renderer = TaskRenderer::local();
+    renderer.appendTask(*this, id);
+    renderer.flushTo(std::cout);
+}
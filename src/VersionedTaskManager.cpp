@@ -0,0 +1,139 @@
+#include "VersionedTaskManager.h"
+#include <atomic>
+#include "TaskRenderer.h"
+#include "TaskReports.h"
+
+VersionedTaskManager::VersionedTaskManager()
+    : names(std::make_shared<StringInterner>()), published(std::make_shared<TaskSnapshot>()) {}
+
+TaskSnapshot::Chunk& VersionedTaskManager::writableChunk(TaskId id) {
+    std::shared_ptr<Page>& page = pages[id >> (TaskSnapshot::ChunkBits + TaskSnapshot::PageBits)];
+    if (page->generation <= publishedGeneration) {
+        page = std::make_shared<Page>(*page);
+        page->generation = publishedGeneration + 1;
+    }
+    std::shared_ptr<const Chunk>& slot = page->chunks[(id >> TaskSnapshot::ChunkBits) & (TaskSnapshot::PageChunks - 1)];
+    if (slot->generation <= publishedGeneration) {
+        auto copy = std::make_shared<Chunk>(*slot);
+        copy->generation = publishedGeneration + 1;
+        slot = copy;
+    }
+    // Only the writer holds non-published objects, so casting away const is safe
+    return const_cast<Chunk&>(*slot);
+}
+
+void VersionedTaskManager::publish() {
+    auto next = std::make_shared<TaskSnapshot>();
+    next->pages.assign(pages.begin(), pages.end());
+    next->nameStorage = names;
+    next->rowCount = rowCount;
+    next->liveCount = liveCount;
+    next->version = ++publishedGeneration;
+    std::atomic_store(&published, std::shared_ptr<const TaskSnapshot>(std::move(next)));
+}
+
+TaskId VersionedTaskManager::addTask(std::unique_ptr<BaseTask> task) {
+    Task value(task->getKind(), std::string(task->getName()), task->getPriority(), task->getEstimatedTime(), task->getDeadline());
+    value.isCompleted = task->isTaskCompleted();
+    return addTask(value);
+}
+
+TaskId VersionedTaskManager::addTask(const Task& task) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    TaskId id = static_cast<TaskId>(rowCount);
+    std::size_t pageIndex = id >> (TaskSnapshot::ChunkBits + TaskSnapshot::PageBits);
+    std::size_t chunkIndex = (id >> TaskSnapshot::ChunkBits) & (TaskSnapshot::PageChunks - 1);
+    std::size_t row = id & (TaskSnapshot::ChunkRows - 1);
+    if (pageIndex == pages.size()) {
+        pages.push_back(std::make_shared<Page>());
+        pages.back()->generation = publishedGeneration + 1;
+    }
+    if (row == 0) {
+        auto fresh = std::make_shared<Chunk>();
+        fresh->generation = publishedGeneration + 1;
+        pages[pageIndex]->chunks[chunkIndex] = fresh;
+    }
+
+    // Slot 'row' is past every published rowCount, so no reader can see it
+    // and it can be filled in place even in a shared chunk.
+    Symbol symbol = names->intern(task.name);
+    Chunk& chunk = const_cast<Chunk&>(*pages[pageIndex]->chunks[chunkIndex]);
+    chunk.names[row] = names->view(symbol);
+    chunk.deadlines[row] = task.deadline;
+    chunk.priorities[row] = task.priority;
+    chunk.estimatedTimes[row] = task.estimatedTime;
+    chunk.flags[row] = task.isCompleted ? TaskSnapshot::CompletedFlag : 0;
+    chunk.kinds[row] = task.kind;
+
+    nextSameName.push_back(TaskStore::npos);
+    if (symbol >= firstByName.size()) {
+        firstByName.resize(symbol + 1, TaskStore::npos);
+        lastByName.resize(symbol + 1, TaskStore::npos);
+    }
+    if (firstByName[symbol] == TaskStore::npos) {
+        firstByName[symbol] = id;
+    } else {
+        nextSameName[lastByName[symbol]] = id;
+    }
+    lastByName[symbol] = id;
+    ++rowCount;
+    ++liveCount;
+    publish();
+    return id;
+}
+
+bool VersionedTaskManager::markTaskComplete(const std::string& taskName) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    Symbol symbol = names->find(taskName);
+    if (symbol == StringInterner::npos || firstByName[symbol] == TaskStore::npos) {
+        return false;
+    }
+    TaskId id = firstByName[symbol];
+    writableChunk(id).flags[id & (TaskSnapshot::ChunkRows - 1)] |= TaskSnapshot::CompletedFlag;
+    publish();
+    return true;
+}
+
+bool VersionedTaskManager::removeTask(const std::string& taskName) {
+    std::lock_guard<std::mutex> lock(writeMutex);
+    Symbol symbol = names->find(taskName);
+    if (symbol == StringInterner::npos || firstByName[symbol] == TaskStore::npos) {
+        return false;
+    }
+    TaskId id = firstByName[symbol];
+    writableChunk(id).flags[id & (TaskSnapshot::ChunkRows - 1)] |= TaskSnapshot::RemovedFlag;
+    --liveCount;
+
+    // Hand the name over to the next live task that shares it
+    firstByName[symbol] = nextSameName[id];
+    if (lastByName[symbol] == id) {
+        lastByName[symbol] = TaskStore::npos;
+    }
+    publish();
+    return true;
+}
+
+std::shared_ptr<const TaskSnapshot> VersionedTaskManager::snapshot() const {
+    return std::atomic_load(&published);
+}
+
+void VersionedTaskManager::displayTasks(std::ostream& out) const {
+    std::shared_ptr<const TaskSnapshot> view = snapshot();
+    TaskRenderer& renderer = TaskRenderer::local();
+    reports::renderAll(*view, renderer);
+    renderer.flushTo(out);
+}
+
+void VersionedTaskManager::displayTasksByPriority(std::ostream& out) const {
+    std::shared_ptr<const TaskSnapshot> view = snapshot();
+    TaskRenderer& renderer = TaskRenderer::local();
+    reports::renderByPriority(*view, renderer);
+    renderer.flushTo(out);
+}
+
+void VersionedTaskManager::displaySortedTasks(std::ostream& out) const {
+    std::shared_ptr<const TaskSnapshot> view = snapshot();
+    TaskRenderer& renderer = TaskRenderer::local();
+    reports::renderSorted(*view, renderer);
+    renderer.flushTo(out);
+}
@@ -0,0 +1,277 @@
+#include "WeeklyPlanner.h"
+#include <algorithm>
+
+namespace {
+
+// Max-tree over the free hours of each day, for first-fit in O(log days)
+class CapacityTree {
+private:
+    std::size_t leaves = 1;
+    std::vector<int> tree;
+
+public:
+    explicit CapacityTree(const std::vector<int>& freeHours) {
+        while (leaves < freeHours.size()) {
+            leaves <<= 1;
+        }
+        tree.assign(2 * leaves, -1); // Padding days never fit anything
+        std::copy(freeHours.begin(), freeHours.end(), tree.begin() + static_cast<std::ptrdiff_t>(leaves));
+        for (std::size_t node = leaves - 1; node > 0; --node) {
+            tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+        }
+    }
+
+    // Earliest day with at least 'hours' free, or -1
+    int firstFit(int hours) const {
+        if (tree[1] < hours) {
+            return -1;
+        }
+        std::size_t node = 1;
+        while (node < leaves) {
+            node = tree[2 * node] >= hours ? 2 * node : 2 * node + 1;
+        }
+        return static_cast<int>(node - leaves);
+    }
+
+    void set(int day, int hours) {
+        std::size_t node = static_cast<std::size_t>(day) + leaves;
+        tree[node] = hours;
+        for (node >>= 1; node > 0; node >>= 1) {
+            tree[node] = std::max(tree[2 * node], tree[2 * node + 1]);
+        }
+    }
+};
+
+struct Piece {
+    std::uint32_t item;  // Index into the sorted items
+    int hours;
+    int day;             // -1 while unplaced
+};
+
+// Working state shared by the greedy pass and the local search
+struct Packing {
+    const std::vector<WeeklyPlanner::Item>& items;
+    std::vector<Piece> pieces;
+    std::vector<std::uint32_t> firstPiece;  // Pieces of item i are [firstPiece[i], firstPiece[i + 1])
+    std::vector<int> freeHours;             // Per day
+    std::vector<int> finish;                // Day of each item's last piece, -1 if unscheduled
+
+    explicit Packing(const std::vector<WeeklyPlanner::Item>& sorted) : items(sorted) {}
+
+    long long weightedLateness(std::uint32_t item, int finishDay) const {
+        const WeeklyPlanner::Item& task = items[item];
+        return static_cast<long long>(std::max(1, task.priority)) * std::max(0, finishDay - task.deadlineDay);
+    }
+
+    // Finish day of 'item' if piece 'moved' were on 'day'
+    int finishWith(std::uint32_t item, std::uint32_t moved, int day) const {
+        int last = 0;
+        for (std::uint32_t p = firstPiece[item]; p < firstPiece[item + 1]; ++p) {
+            last = std::max(last, p == moved ? day : pieces[p].day);
+        }
+        return last;
+    }
+};
+
+void greedyPack(Packing& packing, int pieceLimit) {
+    const auto& items = packing.items;
+    CapacityTree capacity(packing.freeHours);
+    packing.finish.assign(items.size(), -1);
+    packing.firstPiece.reserve(items.size() + 1);
+
+    auto take = [&](std::uint32_t item, int day, int hours) {
+        packing.pieces.push_back(Piece{item, hours, day});
+        packing.freeHours[day] -= hours;
+        capacity.set(day, packing.freeHours[day]);
+        packing.finish[item] = std::max(packing.finish[item], day);
+    };
+
+    for (std::uint32_t i = 0; i < items.size(); ++i) {
+        packing.firstPiece.push_back(static_cast<std::uint32_t>(packing.pieces.size()));
+        int left = std::max(0, items[i].estimatedTime);
+        if (left <= pieceLimit) {
+            // Fits in a day: place it whole on the first day with room
+            int day = capacity.firstFit(left);
+            if (day >= 0) {
+                take(i, day, left);
+            }
+            continue;
+        }
+        // Longer than any day: fill the earliest free hours until it is done
+        std::size_t mark = packing.pieces.size();
+        while (left > 0) {
+            int day = capacity.firstFit(1);
+            if (day < 0) {
+                break;
+            }
+            int hours = std::min(left, packing.freeHours[day]);
+            take(i, day, hours);
+            left -= hours;
+        }
+        if (left > 0) {
+            // Ran out of horizon: give the hours back and leave it unscheduled
+            for (std::size_t p = mark; p < packing.pieces.size(); ++p) {
+                packing.freeHours[packing.pieces[p].day] += packing.pieces[p].hours;
+                capacity.set(packing.pieces[p].day, packing.freeHours[packing.pieces[p].day]);
+            }
+            packing.pieces.resize(mark);
+            packing.finish[i] = -1;
+        }
+    }
+    packing.firstPiece.push_back(static_cast<std::uint32_t>(packing.pieces.size()));
+}
+
+void localSearch(Packing& packing, const PlannerOptions& options) {
+    const auto& items = packing.items;
+    std::vector<std::vector<std::uint32_t>> dayPieces(packing.freeHours.size());
+    for (std::uint32_t p = 0; p < packing.pieces.size(); ++p) {
+        dayPieces[packing.pieces[p].day].push_back(p);
+    }
+    auto relocate = [&](std::uint32_t p, int day) {
+        Piece& piece = packing.pieces[p];
+        std::vector<std::uint32_t>& from = dayPieces[piece.day];
+        *std::find(from.begin(), from.end(), p) = from.back();
+        from.pop_back();
+        packing.freeHours[piece.day] += piece.hours;
+        packing.freeHours[day] -= piece.hours;
+        piece.day = day;
+        dayPieces[day].push_back(p);
+    };
+
+    for (int pass = 0; pass < options.localSearchPasses; ++pass) {
+        // Worst weighted lateness first
+        std::vector<std::uint32_t> late;
+        for (std::uint32_t i = 0; i < items.size(); ++i) {
+            if (packing.finish[i] > items[i].deadlineDay) {
+                late.push_back(i);
+            }
+        }
+        std::sort(late.begin(), late.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return packing.weightedLateness(a, packing.finish[a]) > packing.weightedLateness(b, packing.finish[b]);
+        });
+
+        bool improved = false;
+        for (std::uint32_t t : late) {
+            int lastDay = packing.finish[t];
+            if (lastDay <= items[t].deadlineDay) {
+                continue;
+            }
+            std::uint32_t p = packing.firstPiece[t];
+            while (packing.pieces[p].day != lastDay) {
+                ++p;
+            }
+            int hours = packing.pieces[p].hours;
+            long long before = packing.weightedLateness(t, lastDay);
+            int highest = std::min(lastDay - 1, std::max(0, items[t].deadlineDay));
+            int lowest = std::max(0, highest - options.searchDays);
+            int budget = options.candidatesPerPiece;
+
+            bool moved = false;
+            for (int day = highest; day >= lowest && !moved && budget > 0; --day) {
+                int newFinish = packing.finishWith(t, p, day);
+                long long gain = before - packing.weightedLateness(t, newFinish);
+                if (gain <= 0) {
+                    continue;
+                }
+                if (packing.freeHours[day] >= hours) {
+                    relocate(p, day);
+                    packing.finish[t] = newFinish;
+                    moved = true;
+                    break;
+                }
+                // Swap with a piece whose task can better afford the later day
+                for (std::uint32_t u : dayPieces[day]) {
+                    if (--budget < 0) {
+                        break;
+                    }
+                    Piece& other = packing.pieces[u];
+                    if (other.item == t || packing.freeHours[day] + other.hours < hours
+                        || packing.freeHours[lastDay] + hours < other.hours) {
+                        continue;
+                    }
+                    int otherFinish = packing.finishWith(other.item, u, lastDay);
+                    long long cost = packing.weightedLateness(other.item, otherFinish)
+                                   - packing.weightedLateness(other.item, packing.finish[other.item]);
+                    if (cost < gain) {
+                        std::uint32_t otherItem = other.item;
+                        relocate(u, lastDay);
+                        relocate(p, day);
+                        packing.finish[t] = newFinish;
+                        packing.finish[otherItem] = otherFinish;
+                        moved = true;
+                        break;
+                    }
+                }
+            }
+            improved = improved || moved;
+        }
+        if (!improved) {
+            break;
+        }
+    }
+}
+
+}
+
+int WeeklyPlanner::dayOf(std::chrono::system_clock::time_point when) const {
+    auto hours = std::chrono::duration_cast<std::chrono::hours>(when - options.start).count();
+    // Round towards the earlier day so deadlines before 'start' are negative
+    return static_cast<int>(hours >= 0 ? hours / 24 : -((-hours + 23) / 24));
+}
+
+WeeklyPlan WeeklyPlanner::plan(std::vector<Item> items) const {
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        if (a.deadlineDay != b.deadlineDay) {
+            return a.deadlineDay < b.deadlineDay;
+        }
+        if (a.priority != b.priority) {
+            return a.priority > b.priority;
+        }
+        return a.id < b.id;
+    });
+
+    int days = std::max(0, options.weeks * 7);
+    Packing packing(items);
+    packing.freeHours.resize(static_cast<std::size_t>(days));
+    for (int day = 0; day < days; ++day) {
+        packing.freeHours[day] = std::max(0, options.hoursPerDay[day % 7]);
+    }
+    int pieceLimit = std::max(0, *std::max_element(options.hoursPerDay.begin(), options.hoursPerDay.end()));
+
+    WeeklyPlan result;
+    if (days == 0) {
+        for (const Item& item : items) {
+            result.unscheduled.push_back(item.id);
+        }
+        return result;
+    }
+    greedyPack(packing, pieceLimit);
+    if (options.localSearch) {
+        localSearch(packing, options);
+    }
+
+    result.hoursUsed.resize(static_cast<std::size_t>(days));
+    for (int day = 0; day < days; ++day) {
+        result.hoursUsed[day] = std::max(0, options.hoursPerDay[day % 7]) - packing.freeHours[day];
+    }
+    result.slots.reserve(packing.pieces.size());
+    for (const Piece& piece : packing.pieces) {
+        result.slots.push_back(WeeklyPlan::Slot{items[piece.item].id, piece.day, piece.hours});
+    }
+    std::stable_sort(result.slots.begin(), result.slots.end(),
+                     [](const WeeklyPlan::Slot& a, const WeeklyPlan::Slot& b) { return a.day < b.day; });
+    for (std::uint32_t i = 0; i < items.size(); ++i) {
+        int finish = packing.finish[i];
+        if (finish < 0) {
+            result.unscheduled.push_back(items[i].id);
+            continue;
+        }
+        ++result.plannedTasks;
+        if (finish > items[i].deadlineDay) {
+            ++result.lateTasks;
+            result.totalLatenessDays += finish - items[i].deadlineDay;
+            result.weightedLatenessDays += packing.weightedLateness(i, finish);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,163 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// Lets submit() recognise calls made from one of the pool's own workers
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threadCount) : threads(std::max<std::size_t>(1, threadCount)) {
+    // Workers read 'threads', never 'workers', which is still being filled
+    queues = std::make_unique<Queue[]>(threads);
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    // Workers drain whatever is still queued before they exit
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(Job job) {
+    unfinished.fetch_add(1);
+    // Counted before the push so a worker can never see more jobs than 'queued'
+    queued.fetch_add(1);
+    std::size_t target = currentPool == this ? currentWorker : nextQueue.fetch_add(1) % threads;
+    pushTo(target, std::move(job));
+    wakeWorkers(1);
+}
+
+void WorkStealingPool::submitBatch(std::vector<Job>&& jobs) {
+    std::size_t count = jobs.size();
+    if (count == 0) {
+        return;
+    }
+    unfinished.fetch_add(count);
+    queued.fetch_add(count);
+    std::size_t start = nextQueue.fetch_add(1);
+    for (std::size_t q = 0; q < threads && q < count; ++q) {
+        Queue& queue = queues[(start + q) % threads];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t j = q; j < count; j += threads) {
+            queue.jobs.push_back(std::move(jobs[j]));
+        }
+    }
+    jobs.clear();
+    wakeWorkers(count);
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(doneMutex);
+    allDone.wait(lock, [this] { return unfinished.load() == 0; });
+    if (firstError) {
+        std::rethrow_exception(std::exchange(firstError, nullptr));
+    }
+}
+
+void WorkStealingPool::workerLoop(std::size_t self) {
+    currentPool = this;
+    currentWorker = self;
+    Job job;
+    for (;;) {
+        if (popOwn(self, job) || stealInto(self, job)) {
+            try {
+                job();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(doneMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+            job = nullptr;
+            finished(1);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1);
+        workAvailable.wait(lock, [this] { return queued.load() > 0 || stopping.load(); });
+        sleepers.fetch_sub(1);
+        if (stopping.load() && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::popOwn(std::size_t self, Job& job) {
+    Queue& queue = queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) {
+        return false;
+    }
+    job = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    queued.fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::stealInto(std::size_t self, Job& job) {
+    std::vector<Job> loot;
+    for (std::size_t offset = 1; offset < threads && loot.empty(); ++offset) {
+        Queue& victim = queues[(self + offset) % threads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        std::size_t available = victim.jobs.size();
+        if (available == 0) {
+            continue;
+        }
+        // Take the back half, which holds the victim's least urgent jobs
+        auto first = victim.jobs.end() - static_cast<std::ptrdiff_t>((available + 1) / 2);
+        loot.assign(std::make_move_iterator(first), std::make_move_iterator(victim.jobs.end()));
+        victim.jobs.erase(first, victim.jobs.end());
+    }
+    if (loot.empty()) {
+        return false;
+    }
+    stealCount.fetch_add(1, std::memory_order_relaxed);
+    job = std::move(loot.front());
+    queued.fetch_sub(1);
+    if (loot.size() > 1) {
+        Queue& own = queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.jobs.insert(own.jobs.end(), std::make_move_iterator(loot.begin() + 1), std::make_move_iterator(loot.end()));
+    }
+    return true;
+}
+
+void WorkStealingPool::pushTo(std::size_t queue, Job job) {
+    std::lock_guard<std::mutex> lock(queues[queue].mutex);
+    queues[queue].jobs.push_back(std::move(job));
+}
+
+void WorkStealingPool::wakeWorkers(std::size_t count) {
+    // 'queued' was raised before this check, so a worker that is about to
+    // sleep either sees the new jobs or is counted in 'sleepers'
+    if (sleepers.load() == 0) {
+        return;
+    }
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    if (count == 1) {
+        workAvailable.notify_one();
+    } else {
+        workAvailable.notify_all();
+    }
+}
+
+void WorkStealingPool::finished(std::size_t count) {
+    if (unfinished.fetch_sub(count) == count) {
+        { std::lock_guard<std::mutex> lock(doneMutex); }
+        allDone.notify_all();
+    }
+}
@@ -1,7 +1,24 @@
 #include <gtest/gtest.h>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <algorithm>
 #include "TaskManager.h"
 #include "AiTask.h"
 #include "HpcTask.h"
+#include "TaskStore.h"
+#include "TaskRenderer.h"
+#include "TaskAdapter.h"
+#include "UserManager.h"
+#include "ConcurrentTaskManager.h"
+#include "VersionedTaskManager.h"
+#include "WorkStealingPool.h"
+#include "TaskImporter.h"
+#include "TaskServer.h"
+#include "TaskClient.h"
+#include "BatchRunner.h"
+#include "OpStats.h"
 
 // checking if tasks are added correctly
 TEST(TaskManagerTests, AddTask) {
@@ -48,3 +65,1278 @@ TEST(TaskManagerTests, MarkTaskComplete) {
     EXPECT_TRUE(taskFound);  // Makeing sure the task was found and marked complete
 }
 
+// checking that lookups by name survive reordering and removal
+TEST(TaskManagerTests, MarkTaskCompleteAfterPrioritizeAndRemove) {
+    TaskManager manager;
+    manager.addTask(std::make_unique<HpcTask>("Low task", 1, 5));
+    manager.addTask(std::make_unique<AiTask>("High task", 3, 10));
+    manager.addTask(std::make_unique<AiTask>("Shared name", 2, 1));
+    manager.addTask(std::make_unique<HpcTask>("Shared name", 1, 2));
+    manager.prioritizeTasks();
+
+    EXPECT_TRUE(manager.markTaskComplete("Low task"));
+    EXPECT_FALSE(manager.markTaskComplete("Missing task"));
+
+    EXPECT_TRUE(manager.removeTask("Low task"));
+    EXPECT_FALSE(manager.markTaskComplete("Low task"));
+    EXPECT_TRUE(manager.markTaskComplete("High task"));
+
+    // Removing one of two tasks sharing a name keeps the other reachable
+    EXPECT_TRUE(manager.removeTask("Shared name"));
+    EXPECT_TRUE(manager.markTaskComplete("Shared name"));
+    EXPECT_TRUE(manager.removeTask("Shared name"));
+    EXPECT_FALSE(manager.markTaskComplete("Shared name"));
+
+    // Removed tasks are skipped by the display order
+    std::ostringstream out;
+    manager.displayTasks(out);
+    EXPECT_EQ(out.str().find("Low task"), std::string::npos);
+    EXPECT_NE(out.str().find("High task"), std::string::npos);
+}
+
+// checking that task IDs stay stable when tasks are removed
+TEST(TaskStoreTests, StableIdsAndColumns) {
+    TaskStore store;
+    TaskId first = store.add(TaskKind::Ai, "Train model", 3, 8);
+    TaskId second = store.add(TaskKind::Hpc, "Run simulation", 1, 4);
+    TaskId third = store.add(TaskKind::Devops, "Train model", 2, 1);
+
+    EXPECT_EQ(store.findByName("Train model"), first);
+    EXPECT_TRUE(store.remove(first));
+    EXPECT_FALSE(store.contains(first));
+    EXPECT_EQ(store.size(), 2u);
+
+    // The remaining tasks keep their IDs and the name moves to the next owner
+    EXPECT_EQ(store.findByName("Train model"), third);
+    EXPECT_EQ(store.name(second), "Run simulation");
+    EXPECT_EQ(store.priority(second), 1);
+    EXPECT_EQ(store.kind(third), TaskKind::Devops);
+    EXPECT_EQ(store.findByName("Missing"), TaskStore::npos);
+
+    store.markComplete(second);
+    EXPECT_TRUE(store.isCompleted(second));
+    EXPECT_FALSE(store.isCompleted(third));
+
+    // Duplicates removed from the middle and the end keep the chain intact
+    TaskId fourth = store.add(TaskKind::Ai, "Train model", 1, 1);
+    TaskId fifth = store.add(TaskKind::Ai, "Train model", 1, 1);
+    EXPECT_TRUE(store.remove(fourth));
+    EXPECT_TRUE(store.remove(fifth));
+    TaskId sixth = store.add(TaskKind::Ai, "Train model", 1, 1);
+    EXPECT_TRUE(store.remove(third));
+    EXPECT_EQ(store.findByName("Train model"), sixth);
+    EXPECT_TRUE(store.remove(sixth));
+    EXPECT_EQ(store.findByName("Train model"), TaskStore::npos);
+    TaskId seventh = store.add(TaskKind::Ai, "Train model", 1, 1);
+    EXPECT_EQ(store.findByName("Train model"), seventh);
+}
+
+// checking that a user's tasks are listed by priority and then deadline
+TEST(UserTests, DisplaySortedTasks) {
+    User user("alice", "secret");
+    auto now = std::chrono::system_clock::now();
+
+    auto late = std::make_unique<AiTask>("Later deadline", 3, 2);
+    late->setDeadline(now + std::chrono::hours(48));
+    auto soon = std::make_unique<HpcTask>("Sooner deadline", 3, 2);
+    soon->setDeadline(now + std::chrono::hours(2));
+    auto low = std::make_unique<HpcTask>("Low priority", 1, 2);
+    low->setDeadline(now + std::chrono::hours(1));
+
+    user.addTask(std::move(low));
+    user.addTask(std::move(late));
+    user.addTask(std::move(soon));
+    EXPECT_TRUE(user.markTaskComplete("Low priority"));
+
+    testing::internal::CaptureStdout();
+    user.displaySortedTasks();
+    std::string output = testing::internal::GetCapturedStdout();
+
+    EXPECT_LT(output.find("Sooner deadline"), output.find("Later deadline"));
+    EXPECT_LT(output.find("Later deadline"), output.find("Low priority"));
+    EXPECT_NE(output.find("AI Task: Sooner deadline"), std::string::npos);
+}
+
+// checking that value-type tasks round-trip through the BaseTask adapter
+TEST(TaskTests, AdapterRoundTrip) {
+    Task task(TaskKind::Programming, "Write parser", 2, 6);
+    task.isCompleted = true;
+
+    std::unique_ptr<BaseTask> legacy = toBaseTask(task);
+    EXPECT_NE(dynamic_cast<ProgrammingTask*>(legacy.get()), nullptr);
+    EXPECT_TRUE(legacy->isTaskCompleted());
+
+    Task back = toTask(*legacy);
+    EXPECT_EQ(back.kind, TaskKind::Programming);
+    EXPECT_EQ(back.name, "Write parser");
+    EXPECT_EQ(back.priority, 2);
+    EXPECT_EQ(back.estimatedTime, 6);
+
+    std::ostringstream out;
+    back.print(out);
+    EXPECT_EQ(out.str().find("AI Task: Write parser"), 0u);
+
+    TaskManager manager;
+    TaskId id = manager.addTask(back);
+    EXPECT_EQ(manager.getStore().kind(id), TaskKind::Programming);
+    EXPECT_TRUE(manager.getStore().isCompleted(id));
+}
+
+// checking that the priority report lists every level in order in one block
+TEST(TaskManagerTests, DisplayTasksByPriorityOrder) {
+    TaskManager manager;
+    manager.addTask(Task(TaskKind::Hpc, "Low one", 1, 1));
+    manager.addTask(Task(TaskKind::Ai, "High one", 3, 2));
+    manager.addTask(Task(TaskKind::Devops, "Medium one", 2, 3));
+    manager.addTask(Task(TaskKind::Ai, "High two", 3, 4));
+
+    std::ostringstream out;
+    manager.displayTasksByPriority(out);
+    std::string output = out.str();
+
+    EXPECT_LT(output.find("High Priority Tasks"), output.find("High one"));
+    EXPECT_LT(output.find("High one"), output.find("High two"));
+    EXPECT_LT(output.find("High two"), output.find("Medium Priority Tasks"));
+    EXPECT_LT(output.find("Medium one"), output.find("Low Priority Tasks"));
+    EXPECT_NE(output.find("Devops Task: Medium one | Priority: 2 | Deadline: "), std::string::npos);
+    EXPECT_NE(output.find(" | Estimated Time: 3 hours | Completed: No\n"), std::string::npos);
+
+    // A report larger than the retained capacity does not stay pinned
+    TaskRenderer& renderer = TaskRenderer::local();
+    renderer.append(std::string(TaskRenderer::RetainedCapacity * 2, 'x'));
+    std::ostringstream large;
+    renderer.flushTo(large);
+    EXPECT_EQ(large.str().size(), TaskRenderer::RetainedCapacity * 2);
+    EXPECT_LE(renderer.str().capacity(), TaskRenderer::RetainedCapacity);
+}
+
+// checking that a snapshot round-trips users, tasks and task IDs
+TEST(UserManagerTests, SnapshotRoundTrip) {
+    UserManager manager;
+    ASSERT_TRUE(manager.registerUser("alice", "secret"));
+    ASSERT_TRUE(manager.registerUser("bob", "hunter2"));
+    auto deadline = std::chrono::system_clock::from_time_t(1700000000);
+
+    auto alice = manager.findUser("alice");
+    alice->addTask(Task(TaskKind::Hpc, "Run simulation", 3, 12, deadline));
+    TaskId removed = alice->addTask(Task(TaskKind::Ai, "Scratch task", 1, 1, deadline));
+    TaskId kept = alice->addTask(Task(TaskKind::Devops, "Deploy", 2, 4, deadline));
+    alice->markTaskComplete("Deploy");
+    alice->removeTask("Scratch task");
+
+    std::string path = testing::TempDir() + "snapshot_round_trip.snap";
+    ASSERT_TRUE(manager.saveSnapshot(path));
+
+    UserManager loaded;
+    ASSERT_TRUE(loaded.loadSnapshot(path));
+    EXPECT_EQ(loaded.userCount(), 2u);
+    EXPECT_TRUE(loaded.loginUser("bob", "hunter2"));
+    EXPECT_FALSE(loaded.loginUser("bob", "hunter3"));
+
+    const TaskStore& tasks = loaded.findUser("alice")->getTasks();
+    EXPECT_EQ(tasks.size(), 2u);
+    EXPECT_FALSE(tasks.contains(removed));
+    EXPECT_EQ(tasks.findByName("Deploy"), kept);
+    EXPECT_TRUE(tasks.isCompleted(kept));
+    EXPECT_EQ(tasks.kind(kept), TaskKind::Devops);
+    EXPECT_EQ(tasks.deadline(kept), deadline);
+    EXPECT_EQ(tasks.findByName("Run simulation"), 0u);
+
+    // Only salted hashes reach the file
+    std::string contents;
+    ASSERT_TRUE(binio::readFile(path, contents));
+    EXPECT_EQ(contents.find("hunter2"), std::string::npos);
+    EXPECT_EQ(contents.find("secret"), std::string::npos);
+    auto abc = sha256("abc", 3);
+    EXPECT_EQ(abc[0], 0xba);
+    EXPECT_EQ(abc[31], 0xad);
+    std::string twoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    auto padded = sha256(twoBlocks.data(), twoBlocks.size());
+    EXPECT_EQ(padded[0], 0x24);
+    EXPECT_EQ(padded[31], 0xc1);
+    EXPECT_NE(manager.findUser("alice")->getPasswordHash().salt, manager.findUser("bob")->getPasswordHash().salt);
+
+    // Truncated files are rejected without touching the current state
+    contents.pop_back();
+    EXPECT_FALSE(SnapshotCodec::decode(contents, loaded));
+    EXPECT_EQ(loaded.userCount(), 2u);
+    std::remove(path.c_str());
+}
+
+// checking that logged mutations are replayed on top of the last snapshot
+TEST(UserManagerTests, MutationLogReplay) {
+    std::string snapshot = testing::TempDir() + "wal_replay.snap";
+    std::string logPath = testing::TempDir() + "wal_replay.log";
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+
+    MutationLog::Options options;
+    options.groupCommitSize = 4;
+    {
+        UserManager manager;
+        ASSERT_TRUE(manager.openStorage(snapshot, logPath, options));
+        manager.registerUser("alice", "secret");
+        auto alice = manager.findUser("alice");
+        alice->addTask(Task(TaskKind::Ai, "Before checkpoint", 3, 2));
+        ASSERT_TRUE(manager.checkpoint());
+
+        alice->addTask(Task(TaskKind::Hpc, "After checkpoint", 2, 5));
+        alice->addTask(Task(TaskKind::Devops, "Removed later", 1, 1));
+        alice->markTaskComplete("Before checkpoint");
+        alice->removeTask("Removed later");
+        manager.registerUser("bob", "hunter2");
+        // Destruction syncs whatever is still buffered
+    }
+
+    // Registrations are logged as salted hashes, never as the password
+    std::string logContents;
+    ASSERT_TRUE(binio::readFile(logPath, logContents));
+    EXPECT_EQ(logContents.find("hunter2"), std::string::npos);
+
+    // Simulate a crash in the middle of writing a record
+    std::FILE* file = std::fopen(logPath.c_str(), "ab");
+    std::fputs("torn", file);
+    std::fclose(file);
+
+    UserManager restored;
+    ASSERT_TRUE(restored.openStorage(snapshot, logPath, options));
+    EXPECT_EQ(restored.userCount(), 2u);
+    EXPECT_TRUE(restored.findUser("bob")->checkPassword("hunter2"));
+    EXPECT_FALSE(restored.findUser("bob")->checkPassword("secret"));
+    const TaskStore& tasks = restored.findUser("alice")->getTasks();
+    EXPECT_EQ(tasks.size(), 2u);
+    EXPECT_TRUE(tasks.isCompleted(tasks.findByName("Before checkpoint")));
+    EXPECT_EQ(tasks.priority(tasks.findByName("After checkpoint")), 2);
+    EXPECT_EQ(tasks.findByName("Removed later"), TaskStore::npos);
+
+    // New records land after the discarded tail and survive another restart
+    restored.findUser("bob")->addTask(Task(TaskKind::Ai, "Bob task", 1, 1));
+    ASSERT_TRUE(restored.syncLog());
+    UserManager again;
+    ASSERT_TRUE(again.openStorage(snapshot, logPath, options));
+    EXPECT_NE(again.findUser("bob")->getTasks().findByName("Bob task"), TaskStore::npos);
+    EXPECT_EQ(again.findUser("alice")->getTasks().size(), 2u);
+
+    // A record whose checksum holds but whose task kind is unknown ends the
+    // replay like a torn tail: rewrite the last record's kind byte
+    ASSERT_TRUE(binio::readFile(logPath, logContents));
+    std::size_t last = 0;
+    for (std::size_t offset = 8; offset < logContents.size();) {  // Past magic and version
+        std::uint32_t length;
+        std::memcpy(&length, logContents.data() + offset, sizeof(length));
+        last = offset;
+        offset += 8 + length;
+    }
+    std::size_t kindAt = logContents.find("Bob task", last) + 8;
+    ASSERT_LT(kindAt, logContents.size());
+    logContents[kindAt] = static_cast<char>(TaskKindCount);
+    std::uint32_t sum = 2166136261u;  // FNV-1a of the body
+    for (std::size_t i = last + 8; i < logContents.size(); ++i) {
+        sum = (sum ^ static_cast<unsigned char>(logContents[i])) * 16777619u;
+    }
+    binio::Writer(logContents).putAt(last + 4, sum);
+    ASSERT_TRUE(binio::writeFileAtomically(logPath, logContents));
+    UserManager corrupt;
+    ASSERT_TRUE(corrupt.openStorage(snapshot, logPath, options));
+    EXPECT_EQ(corrupt.findUser("bob")->getTasks().size(), 0u);
+    EXPECT_EQ(corrupt.findUser("alice")->getTasks().size(), 2u);
+
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+}
+
+// checking that a read-only task file is queried in place
+TEST(TaskManagerTests, ReadOnlyMappedStore) {
+    auto now = std::chrono::system_clock::now();
+    TaskManager writer;
+    writer.addTask(Task(TaskKind::Hpc, "Overdue job", 3, 4, now - std::chrono::hours(2)));
+    writer.addTask(Task(TaskKind::Ai, "Dropped", 2, 1, now + std::chrono::hours(2)));
+    writer.addTask(Task(TaskKind::Devops, "Future job", 1, 2, now + std::chrono::hours(5)));
+    writer.markTaskComplete("Future job");
+    writer.removeTask("Dropped");
+
+    std::string path = testing::TempDir() + "read_only.mapped";
+    ASSERT_TRUE(writer.saveReadOnly(path));
+
+    TaskManager reader;
+    ASSERT_TRUE(reader.openReadOnly(path));
+    EXPECT_TRUE(reader.isReadOnly());
+    EXPECT_EQ(reader.taskCount(), 2u);
+    EXPECT_EQ(reader.overdueTasks(now), std::vector<TaskId>{0});
+    EXPECT_EQ(reader.tasksWithPriority(1), std::vector<TaskId>{2});
+    EXPECT_TRUE(reader.tasksWithPriority(2).empty());
+
+    std::ostringstream out;
+    reader.displayTasksByPriority(out);
+    EXPECT_NE(out.str().find("AI Task: Overdue job | Priority: 3"), std::string::npos);
+    EXPECT_NE(out.str().find("Devops Task: Future job | Priority: 1"), std::string::npos);
+    EXPECT_NE(out.str().find("Completed: Yes"), std::string::npos);
+    EXPECT_EQ(out.str().find("Dropped"), std::string::npos);
+
+    EXPECT_FALSE(reader.markTaskComplete("Overdue job"));
+    EXPECT_EQ(reader.addTask(Task(TaskKind::Ai, "New", 1, 1)), TaskStore::npos);
+    EXPECT_FALSE(reader.openReadOnly(path + ".missing"));
+    std::remove(path.c_str());
+}
+
+// checking that overdue and due-soon tasks come from the deadline index
+TEST(UserTests, DeadlineIndexGroups) {
+    User user("alice", "secret");
+    auto now = std::chrono::system_clock::now();
+    user.addTask(Task(TaskKind::Ai, "Next week", 1, 1, now + std::chrono::hours(24 * 7)));
+    user.addTask(Task(TaskKind::Ai, "Late", 2, 1, now - std::chrono::hours(3)));
+    user.addTask(Task(TaskKind::Hpc, "Tonight", 3, 1, now + std::chrono::hours(6)));
+    user.addTask(Task(TaskKind::Hpc, "Very late", 1, 1, now - std::chrono::hours(30)));
+    user.removeTask("Late");
+
+    const DeadlineIndex& index = user.getDeadlineIndex();
+    std::vector<TaskId> overdue = index.overdue(now);
+    ASSERT_EQ(overdue.size(), 1u);
+    EXPECT_EQ(user.getTasks().name(overdue[0]), "Very late");
+    std::vector<TaskId> dueSoon = index.dueBetween(now, now + std::chrono::hours(24));
+    ASSERT_EQ(dueSoon.size(), 1u);
+    EXPECT_EQ(user.getTasks().name(dueSoon[0]), "Tonight");
+
+    testing::internal::CaptureStdout();
+    user.notifyOverdueTasks();
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(output.find("Very late"), std::string::npos);
+    EXPECT_EQ(output.find("Tonight"), std::string::npos);
+}
+
+// checking that the watcher fires once a task passes its deadline
+TEST(UserTests, WatchDeadlinesFiresCallbacks) {
+    User user("alice", "secret");
+    auto now = std::chrono::system_clock::now();
+    TaskId expiring = user.addTask(Task(TaskKind::Ai, "Expiring", 1, 1, now + std::chrono::milliseconds(50)));
+    user.addTask(Task(TaskKind::Ai, "Completed", 1, 1, now + std::chrono::milliseconds(100)));
+    user.addTask(Task(TaskKind::Ai, "Far away", 1, 1, now + std::chrono::hours(1)));
+
+    std::atomic<int> fired(0);
+    std::atomic<TaskId> firedId(TaskStore::npos);
+    user.watchDeadlines([&](TaskId id) {
+        firedId = id;
+        ++fired;
+    });
+    user.markTaskComplete("Completed");
+
+    for (int i = 0; i < 200 && fired == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(fired, 1);
+    EXPECT_EQ(firedId, expiring);
+    user.stopWatchingDeadlines();
+
+    // Rescheduling the same key keeps the heap bounded
+    DeadlineWatcher watcher([](std::uint64_t) {});
+    for (int i = 0; i < 10000; ++i) {
+        watcher.schedule(7, now + std::chrono::hours(1) + std::chrono::seconds(i));
+    }
+    EXPECT_EQ(watcher.pending(), 1u);
+    EXPECT_LE(watcher.queued(), 66u);
+}
+
+// checking concurrent adds and completions from several threads
+TEST(ConcurrentTaskManagerTests, ParallelAddAndComplete) {
+    ConcurrentTaskManager manager(8);
+    const int threads = 4;
+    const int perThread = 500;
+    std::vector<std::thread> workers;
+    std::atomic<int> completed(0);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < perThread; ++i) {
+                std::string name = "t" + std::to_string(t) + "-" + std::to_string(i);
+                manager.addTask(Task(TaskKind::Ai, name, i % 3 + 1, 1));
+                if (i % 2 == 0 && manager.markTaskComplete(name)) {
+                    ++completed;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(manager.taskCount(), static_cast<std::size_t>(threads * perThread));
+    EXPECT_EQ(completed, threads * perThread / 2);
+    EXPECT_TRUE(manager.removeTask("t0-0"));
+    EXPECT_FALSE(manager.markTaskComplete("t0-0"));
+
+    std::ostringstream out;
+    manager.displayTasksByPriority(out);
+    EXPECT_LT(out.str().find("t1-2 |"), out.str().find("Medium Priority Tasks"));
+}
+
+// checking that a full shard refuses tasks instead of reusing IDs
+TEST(ConcurrentTaskManagerTests, FullShardFailsAdd) {
+    ConcurrentTaskManager manager(1 << 14);  // 18 bits of ID per shard
+    constexpr TaskId PerShard = (TaskId(1) << 18) - 1;
+    Task task(TaskKind::Ai, "Same shard", 1, 1);
+    TaskId last = 0;
+    for (TaskId i = 0; i < PerShard; ++i) {
+        last = manager.addTask(task);
+    }
+    EXPECT_NE(last, TaskStore::npos);
+    EXPECT_EQ(manager.addTask(task), TaskStore::npos);
+    EXPECT_EQ(manager.taskCount(), static_cast<std::size_t>(PerShard));
+}
+
+// checking that a snapshot keeps its view while newer versions are published
+TEST(VersionedTaskManagerTests, SnapshotsAreIsolated) {
+    VersionedTaskManager manager;
+    for (int i = 0; i < 600; ++i) {
+        manager.addTask(Task(TaskKind::Ai, "task-" + std::to_string(i), i % 3 + 1, 1));
+    }
+    std::shared_ptr<const TaskSnapshot> before = manager.snapshot();
+
+    EXPECT_TRUE(manager.markTaskComplete("task-10"));
+    EXPECT_TRUE(manager.removeTask("task-300"));
+    // Earliest deadline of all the high-priority tasks, so it sorts first
+    manager.addTask(Task(TaskKind::Devops, "late arrival", 3, 1, TaskSnapshot::TimePoint() - std::chrono::hours(1)));
+    std::shared_ptr<const TaskSnapshot> after = manager.snapshot();
+
+    EXPECT_EQ(before->size(), 600u);
+    EXPECT_FALSE(before->isCompleted(10));
+    EXPECT_TRUE(before->contains(300));
+    EXPECT_EQ(after->size(), 600u);
+    EXPECT_TRUE(after->isCompleted(10));
+    EXPECT_FALSE(after->contains(300));
+    EXPECT_EQ(after->name(600), "late arrival");
+    EXPECT_GT(after->getVersion(), before->getVersion());
+
+    std::ostringstream out;
+    manager.displaySortedTasks(out);
+    EXPECT_EQ(out.str().find("Devops Task: late arrival"), 0u);
+    EXPECT_EQ(out.str().find("task-300 |"), std::string::npos);
+}
+
+// checking that the priority order stays sorted across completes, updates and removals
+TEST(TaskManagerTests, PriorityOrderIsMaintained) {
+    TaskManager manager;
+    auto base = TaskStore::TimePoint(std::chrono::hours(1000));
+    manager.addTask(Task(TaskKind::Ai, "low", 1, 1, base));
+    manager.addTask(Task(TaskKind::Ai, "high late", 3, 1, base + std::chrono::hours(2)));
+    manager.addTask(Task(TaskKind::Ai, "high early", 3, 1, base + std::chrono::hours(1)));
+    manager.addTask(Task(TaskKind::Ai, "medium", 2, 1, base));
+
+    const PriorityIndex& index = manager.getPriorityIndex();
+    EXPECT_EQ(index.sorted(), (std::vector<TaskId>{2, 1, 3, 0}));
+
+    EXPECT_TRUE(manager.markTaskComplete("high early"));
+    EXPECT_EQ(index.top(2), (std::vector<TaskId>{1, 3}));
+    EXPECT_EQ(index.sorted(), (std::vector<TaskId>{2, 1, 3, 0}));
+
+    EXPECT_TRUE(manager.updateTask("low", 3, base));
+    EXPECT_TRUE(manager.removeTask("medium"));
+    EXPECT_EQ(index.sorted(), (std::vector<TaskId>{0, 2, 1}));
+    EXPECT_EQ(index.openCount(), 2u);
+
+    manager.prioritizeTasks();
+    std::ostringstream out;
+    manager.displayTasks(out);
+    EXPECT_LT(out.str().find("low |"), out.str().find("high early |"));
+    EXPECT_FALSE(manager.updateTask("missing", 1, base));
+}
+
+// checking top-k selection with filters and custom scoring
+TEST(TaskManagerTests, NextTasks) {
+    TaskManager manager;
+    auto now = TaskStore::TimePoint(std::chrono::hours(1000));
+    manager.addTask(Task(TaskKind::Ai, "big", 3, 40, now + std::chrono::hours(48)));
+    manager.addTask(Task(TaskKind::Hpc, "urgent", 2, 2, now + std::chrono::hours(1)));
+    manager.addTask(Task(TaskKind::Ai, "quick", 3, 1, now + std::chrono::hours(72)));
+    manager.addTask(Task(TaskKind::Devops, "done", 3, 1, now));
+    manager.addTask(Task(TaskKind::Ai, "someday", 1, 5, now + std::chrono::hours(500)));
+    manager.markTaskComplete("done");
+
+    std::vector<TaskHandle> next = manager.nextTasks(2);
+    ASSERT_EQ(next.size(), 2u);
+    EXPECT_EQ(next[0].id, 0u);
+    EXPECT_EQ(next[1].id, 2u);
+
+    TaskFilter shortOnly;
+    shortOnly.maxEstimatedTime = 5;
+    next = manager.nextTasks(10, shortOnly);
+    ASSERT_EQ(next.size(), 3u);
+    EXPECT_EQ(next[0].id, 2u);
+    EXPECT_EQ(next[2].id, 4u);
+
+    TaskScoring deadlineFirst;
+    deadlineFirst.now = now;
+    deadlineFirst.urgencyWeight = 10.0;
+    next = manager.nextTasks(1, TaskFilter(), deadlineFirst);
+    ASSERT_EQ(next.size(), 1u);
+    EXPECT_EQ(next[0].id, 1u);
+
+    TaskScoring quickWins;
+    quickWins.effortWeight = -1.0;
+    next = manager.nextTasks(3, TaskFilter().onlyKind(TaskKind::Ai), quickWins);
+    ASSERT_EQ(next.size(), 3u);
+    EXPECT_EQ(next[0].id, 2u);
+    EXPECT_EQ(next[1].id, 4u);
+    EXPECT_EQ(next[2].id, 0u);
+    EXPECT_TRUE(manager.nextTasks(0).empty());
+}
+
+// checking that run() executes payloads on the pool and completes their tasks
+TEST(TaskManagerTests, RunExecutesPayloads) {
+    TaskManager manager;
+    std::atomic<int> ran(0);
+    for (int i = 0; i < 1000; ++i) {
+        manager.addTask(Task(TaskKind::Hpc, "job-" + std::to_string(i), i % 3 + 1, 1), [&ran] { ++ran; });
+    }
+    manager.addTask(Task(TaskKind::Ai, "no payload", 3, 1));
+    manager.addTask(Task(TaskKind::Ai, "fails", 3, 1), [] { throw std::runtime_error("failed"); });
+
+    WorkStealingPool pool(4);
+    EXPECT_EQ(manager.run(pool), 1000u);
+    EXPECT_EQ(ran, 1000);
+    EXPECT_TRUE(manager.getStore().isCompleted(0));
+    EXPECT_FALSE(manager.getStore().isCompleted(1000));
+    EXPECT_FALSE(manager.getStore().isCompleted(1001));
+    EXPECT_EQ(manager.getPriorityIndex().openCount(), 2u);
+
+    // Completed payloads are not run again
+    EXPECT_EQ(manager.run(pool), 0u);
+    EXPECT_EQ(ran, 1000);
+
+    // Jobs may submit more jobs; wait() covers them too
+    std::atomic<int> nested(0);
+    for (int i = 0; i < 8; ++i) {
+        pool.submit([&] {
+            for (int j = 0; j < 100; ++j) {
+                pool.submit([&nested] { ++nested; });
+            }
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(nested, 800);
+
+    // A throwing job neither kills its worker nor stalls wait(), which
+    // rethrows its exception once
+    std::atomic<int> after(0);
+    for (int i = 0; i < 100; ++i) {
+        pool.submit([&after, i] {
+            ++after;
+            if (i % 10 == 0) {
+                throw std::runtime_error("job failed");
+            }
+        });
+    }
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_EQ(after, 100);
+    pool.submit([&after] { ++after; });
+    EXPECT_NO_THROW(pool.wait());
+    EXPECT_EQ(after, 101);
+}
+
+// checking EDF, WSJF and hybrid plans and their predicted lateness
+TEST(SchedulerTests, PoliciesAndLateness) {
+    auto start = TaskStore::TimePoint(std::chrono::hours(1000));
+    User user("planner", "pw");
+    user.addTask(Task(TaskKind::Ai, "long important", 3, 10, start + std::chrono::hours(100)));
+    user.addTask(Task(TaskKind::Ai, "short", 2, 1, start + std::chrono::hours(50)));
+    user.addTask(Task(TaskKind::Ai, "due soon", 1, 4, start + std::chrono::hours(3)));
+
+    ScheduleOptions options;
+    options.start = start;
+    options.policy = SchedulePolicy::EarliestDeadline;
+    Scheduler& scheduler = user.enableScheduling(options);
+    EXPECT_EQ(scheduler.order(), (std::vector<TaskId>{2, 1, 0}));
+    ScheduleSummary summary = scheduler.summary();
+    EXPECT_EQ(summary.lateTasks, 1u);
+    EXPECT_DOUBLE_EQ(summary.totalLatenessHours, 1.0);
+
+    options.policy = SchedulePolicy::WeightedShortestJob;
+    scheduler.setOptions(options);
+    EXPECT_EQ(scheduler.order(), (std::vector<TaskId>{1, 0, 2}));
+    EXPECT_DOUBLE_EQ(scheduler.summary().totalLatenessHours, 12.0);
+
+    options.policy = SchedulePolicy::Hybrid;
+    scheduler.setOptions(options);
+    EXPECT_EQ(scheduler.order(), (std::vector<TaskId>{2, 1, 0}));
+
+    // Completing a task only re-times the plan after it
+    EXPECT_TRUE(user.markTaskComplete("short"));
+    EXPECT_EQ(scheduler.order(), (std::vector<TaskId>{2, 0}));
+    EXPECT_EQ(scheduler.lastReplanSize(), 1u);
+    PlannedTask slot;
+    ASSERT_TRUE(scheduler.find(0, slot));
+    EXPECT_DOUBLE_EQ(slot.startHours, 4.0);
+    EXPECT_DOUBLE_EQ(slot.finishHours, 14.0);
+    EXPECT_FALSE(scheduler.find(1, slot));
+
+    user.addTask(Task(TaskKind::Ai, "tiny", 3, 1, start + std::chrono::hours(200)));
+    EXPECT_TRUE(user.updateTask("due soon", 1, start + std::chrono::hours(500)));
+    EXPECT_EQ(scheduler.order(), (std::vector<TaskId>{3, 0, 2}));
+    EXPECT_EQ(scheduler.summary().lateTasks, 0u);
+}
+
+// checking dependency ordering, cycle rejection, critical path and ready tracking
+TEST(TaskGraphTests, DependenciesAndCriticalPath) {
+    TaskManager manager;
+    TaskId build = manager.addTask(Task(TaskKind::Devops, "build", 2, 3));
+    TaskId test = manager.addTask(Task(TaskKind::Devops, "test", 2, 5));
+    TaskId docs = manager.addTask(Task(TaskKind::Programming, "docs", 1, 1));
+    TaskId deploy = manager.addTask(Task(TaskKind::Devops, "deploy", 3, 2));
+
+    // Added out of order, so the topological order has to be repaired
+    EXPECT_TRUE(manager.addDependency(deploy, test));
+    EXPECT_TRUE(manager.addDependency(deploy, docs));
+    EXPECT_TRUE(manager.addDependency(test, build));
+    EXPECT_FALSE(manager.addDependency(build, deploy));
+    EXPECT_FALSE(manager.addDependency(build, build));
+    EXPECT_EQ(manager.getGraph().dependencyCount(), 3u);
+
+    std::vector<TaskId> order = manager.getGraph().topologicalOrder();
+    auto at = [&](TaskId id) { return std::find(order.begin(), order.end(), id) - order.begin(); };
+    EXPECT_LT(at(build), at(test));
+    EXPECT_LT(at(test), at(deploy));
+    EXPECT_LT(at(docs), at(deploy));
+
+    CriticalPath path = manager.getGraph().criticalPath();
+    EXPECT_EQ(path.length, 10);
+    EXPECT_EQ(path.tasks, (std::vector<TaskId>{build, test, deploy}));
+
+    TaskId ready;
+    std::vector<TaskId> popped;
+    while (manager.popReadyTask(ready)) {
+        popped.push_back(ready);
+    }
+    EXPECT_EQ(popped, (std::vector<TaskId>{build, docs}));
+
+    EXPECT_TRUE(manager.markTaskComplete("build"));
+    ASSERT_TRUE(manager.popReadyTask(ready));
+    EXPECT_EQ(ready, test);
+    EXPECT_FALSE(manager.getGraph().isReady(deploy));
+    EXPECT_EQ(manager.getGraph().criticalPath().length, 7);
+
+    // Removing a prerequisite releases its dependents
+    EXPECT_TRUE(manager.removeTask("docs"));
+    EXPECT_TRUE(manager.markTaskComplete("test"));
+    EXPECT_TRUE(manager.getGraph().isReady(deploy));
+}
+
+// checking that run() starts dependents only after their prerequisites finish
+TEST(TaskGraphTests, RunHonorsDependencies) {
+    TaskManager manager;
+    std::mutex mutex;
+    std::vector<std::string> finished;
+    auto record = [&](const char* name) {
+        return [&, name] {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(name);
+        };
+    };
+    TaskId fetch = manager.addTask(Task(TaskKind::Hpc, "fetch", 1, 1), record("fetch"));
+    TaskId compute = manager.addTask(Task(TaskKind::Hpc, "compute", 3, 1), record("compute"));
+    TaskId publish = manager.addTask(Task(TaskKind::Hpc, "publish", 3, 1), record("publish"));
+    TaskId blocked = manager.addTask(Task(TaskKind::Hpc, "blocked", 3, 1), record("blocked"));
+    TaskId failing = manager.addTask(Task(TaskKind::Hpc, "failing", 3, 1), [] { throw std::runtime_error("x"); });
+    ASSERT_TRUE(manager.addDependency(compute, fetch));
+    ASSERT_TRUE(manager.addDependency(publish, compute));
+    ASSERT_TRUE(manager.addDependency(blocked, failing));
+
+    WorkStealingPool pool(3);
+    EXPECT_EQ(manager.run(pool), 3u);
+    EXPECT_EQ(finished, (std::vector<std::string>{"fetch", "compute", "publish"}));
+    EXPECT_TRUE(manager.getStore().isCompleted(publish));
+    EXPECT_FALSE(manager.getStore().isCompleted(blocked));
+}
+
+// checking that the weekly planner respects capacities, deadlines and priorities
+TEST(WeeklyPlannerTests, PacksTasksIntoDays) {
+    auto start = TaskStore::TimePoint(std::chrono::hours(24 * 1000));
+    auto day = [&](int d) { return start + std::chrono::hours(24 * d + 12); };
+    User user("planner", "pw");
+    user.addTask(Task(TaskKind::Ai, "report", 1, 6, day(0)));
+    user.addTask(Task(TaskKind::Ai, "review", 3, 6, day(0)));
+    user.addTask(Task(TaskKind::Ai, "filler", 2, 2, day(3)));
+    user.addTask(Task(TaskKind::Ai, "migration", 2, 20, day(10)));
+    user.addTask(Task(TaskKind::Ai, "too big", 1, 1000, day(5)));
+
+    PlannerOptions options;
+    options.start = start;
+    options.weeks = 2;
+    WeeklyPlan plan = user.planWeeks(options);
+
+    EXPECT_EQ(plan.unscheduled, (std::vector<TaskId>{4}));
+    EXPECT_EQ(plan.plannedTasks, 4u);
+    for (std::size_t d = 0; d < plan.hoursUsed.size(); ++d) {
+        EXPECT_LE(plan.hoursUsed[d], options.hoursPerDay[d % 7]);
+    }
+    // Both 6 hour tasks are due on day 0; the high-priority one gets it
+    ASSERT_FALSE(plan.slots.empty());
+    EXPECT_EQ(plan.slots[0].id, 1u);
+    EXPECT_EQ(plan.slots[0].day, 0);
+    EXPECT_EQ(plan.lateTasks, 1u);
+    EXPECT_EQ(plan.totalLatenessDays, 1);
+
+    int migrationHours = 0;
+    for (const WeeklyPlan::Slot& slot : plan.slots) {
+        if (slot.id == 3) {
+            migrationHours += slot.hours;
+        }
+    }
+    EXPECT_EQ(migrationHours, 20);
+}
+
+// checking that task names and usernames share interned symbols
+TEST(SymbolTableTests, InternedNamesCompareBySymbol) {
+    AiTask first("Interned task name", 3, 2);
+    HpcTask second("Interned task name", 1, 4);
+    AiTask other("Another task name", 2, 1);
+    EXPECT_TRUE(first.hasSameName(second));
+    EXPECT_FALSE(first.hasSameName(other));
+    EXPECT_EQ(first.getName(), "Interned task name");
+    // Both tasks view the same pooled bytes
+    EXPECT_EQ(first.getName().data(), second.getName().data());
+    EXPECT_EQ(SymbolTable::global().find("Interned task name"), first.getNameSymbol());
+
+    UserManager manager;
+    ASSERT_TRUE(manager.registerUser("symbol-user", "pw"));
+    EXPECT_FALSE(manager.registerUser(std::string("symbol-user"), "other"));
+    auto user = manager.findUser("symbol-user");
+    ASSERT_NE(user, nullptr);
+    EXPECT_EQ(user->getUsername(), "symbol-user");
+    EXPECT_EQ(user->getUsernameSymbol(), SymbolTable::global().find("symbol-user"));
+    EXPECT_EQ(manager.findUser(user->getUsernameSymbol()), user);
+    EXPECT_EQ(manager.findUser("never-registered-user"), nullptr);
+    EXPECT_TRUE(manager.loginUser("symbol-user", "pw"));
+    EXPECT_FALSE(manager.loginUser("symbol-user", "wrong"));
+
+    // A name is freed with its last holder, copies included
+    {
+        AiTask transient("Short-lived task name", 1, 1);
+        AiTask copy = transient;
+        EXPECT_TRUE(copy.hasSameName(transient));
+        copy = other;
+        EXPECT_EQ(copy.getName(), "Another task name");
+        EXPECT_NE(SymbolTable::global().find("Short-lived task name"), StringInterner::npos);
+    }
+    EXPECT_EQ(SymbolTable::global().find("Short-lived task name"), StringInterner::npos);
+    EXPECT_EQ(other.getName(), "Another task name");
+    {
+        UserManager scoped;
+        scoped.registerUser("short-lived-user", "pw");
+    }
+    EXPECT_EQ(SymbolTable::global().find("short-lived-user"), StringInterner::npos);
+}
+
+// checking that index nodes come from the per-instance arena and are reused
+TEST(TaskArenaTests, IndexNodesLiveInArena) {
+    TaskManager manager;
+    for (int i = 0; i < 1000; ++i) {
+        manager.addTask(Task(TaskKind::Ai, "Arena task " + std::to_string(i), i % 3 + 1, 1));
+    }
+    const TaskArena& arena = manager.getArena();
+    EXPECT_EQ(arena.liveBlockCount(), 1000u);
+    std::size_t slabs = arena.slabCount();
+    EXPECT_LE(slabs, 2u);
+
+    EXPECT_TRUE(manager.removeTask("Arena task 10"));
+    EXPECT_EQ(arena.liveBlockCount(), 999u);
+    manager.addTask(Task(TaskKind::Hpc, "Arena task again", 3, 1));
+    EXPECT_EQ(arena.liveBlockCount(), 1000u);
+    EXPECT_EQ(arena.slabCount(), slabs);
+    EXPECT_EQ(manager.getPriorityIndex().size(), 1000u);
+
+    User user("arena-user", "pw");
+    user.addTask(Task(TaskKind::Ai, "User arena task", 2, 1));
+    // One deadline node and one priority node
+    EXPECT_EQ(user.getArena().liveBlockCount(), 2u);
+    EXPECT_TRUE(user.removeTask("User arena task"));
+    EXPECT_EQ(user.getArena().liveBlockCount(), 0u);
+}
+
+// checking that bulk ingestion matches adding tasks one at a time
+TEST(TaskManagerTests, AddTasksBatch) {
+    auto now = std::chrono::system_clock::now();
+    std::vector<Task> batch;
+    for (int i = 0; i < 50; ++i) {
+        batch.emplace_back(TaskKind::Programming, "Batch " + std::to_string(i), i % 3 + 1, i % 7, now + std::chrono::hours(50 - i));
+    }
+    batch[3].isCompleted = true;
+
+    TaskManager single;
+    TaskManager bulk;
+    single.addTask(Task(TaskKind::Ai, "Existing", 2, 1, now));
+    bulk.addTask(Task(TaskKind::Ai, "Existing", 2, 1, now));
+    for (const Task& task : batch) {
+        single.addTask(task);
+    }
+    EXPECT_EQ(bulk.addTasks(batch), 1u);
+    EXPECT_EQ(bulk.addTasks(nullptr, 0), TaskStore::npos);
+
+    EXPECT_EQ(bulk.taskCount(), 51u);
+    EXPECT_EQ(bulk.getPriorityIndex().sorted(), single.getPriorityIndex().sorted());
+    EXPECT_EQ(bulk.getPriorityIndex().openCount(), 50u);
+    EXPECT_TRUE(bulk.markTaskComplete("Batch 10"));
+    EXPECT_TRUE(bulk.getGraph().contains(50));
+
+    User singleUser("batch-user", "pw");
+    User bulkUser("batch-user", "pw");
+    singleUser.addTask(Task(TaskKind::Ai, "Existing", 2, 1, now - std::chrono::hours(1)));
+    bulkUser.addTask(Task(TaskKind::Ai, "Existing", 2, 1, now - std::chrono::hours(1)));
+    for (const Task& task : batch) {
+        singleUser.addTask(task);
+    }
+    EXPECT_EQ(bulkUser.addTasks(batch), 1u);
+    EXPECT_EQ(bulkUser.getTasks().size(), 51u);
+    EXPECT_EQ(bulkUser.getPriorityIndex().sorted(), singleUser.getPriorityIndex().sorted());
+    EXPECT_EQ(bulkUser.getDeadlineIndex().dueBetween(now, now + std::chrono::hours(100)),
+              singleUser.getDeadlineIndex().dueBetween(now, now + std::chrono::hours(100)));
+    EXPECT_EQ(bulkUser.getDeadlineIndex().overdue(now), std::vector<TaskId>{0});
+}
+
+// checking that a batch crossing the compaction threshold is not replayed twice
+TEST(UserManagerTests, AddTasksBatchSurvivesCompaction) {
+    std::string snapshot = testing::TempDir() + "batch_compact.snap";
+    std::string logPath = testing::TempDir() + "batch_compact.log";
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+
+    MutationLog::Options options;
+    options.groupCommitSize = 1;
+    options.compactionBytes = 2000;
+    std::vector<Task> batch;
+    for (int i = 0; i < 100; ++i) {
+        batch.emplace_back(TaskKind::Devops, "Batch " + std::to_string(i), i % 3 + 1, 1);
+    }
+    {
+        UserManager manager;
+        ASSERT_TRUE(manager.openStorage(snapshot, logPath, options));
+        manager.registerUser("alice", "secret");
+        manager.findUser("alice")->addTasks(batch);
+        manager.findUser("alice")->addTask(Task(TaskKind::Ai, "After batch", 1, 1));
+        EXPECT_EQ(manager.findUser("alice")->getTasks().size(), 101u);
+    }
+
+    UserManager restored;
+    ASSERT_TRUE(restored.openStorage(snapshot, logPath, options));
+    EXPECT_EQ(restored.findUser("alice")->getTasks().size(), 101u);
+    EXPECT_EQ(restored.findUser("alice")->getTasks().capacity(), 101u);
+
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+}
+
+// checking that CSV and JSON Lines exports are parsed and merged into users
+TEST(TaskImporterTests, ImportsCsvAndJsonLines) {
+    std::chrono::system_clock::time_point deadline;
+    ASSERT_TRUE(TaskImporter::parseDeadline("2025-03-01T09:30:00Z", deadline));
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(deadline), 1740821400);
+    ASSERT_TRUE(TaskImporter::parseDeadline("2025-03-01T11:30:00+02:00", deadline));
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(deadline), 1740821400);
+    ASSERT_TRUE(TaskImporter::parseDeadline("2025-03-01", deadline));
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(deadline), 1740787200);
+    EXPECT_FALSE(TaskImporter::parseDeadline("2025-02-30", deadline));
+    EXPECT_FALSE(TaskImporter::parseDeadline("2025-03-01T25:00", deadline));
+
+    WorkStealingPool pool(2);
+    UserManager users;
+    users.registerUser("alice", "secret");
+
+    std::string csv =
+        "name,kind,priority,estimatedTime,deadline,owner\n"
+        "Train model,ai,3,10,2025-03-01T09:30:00Z,alice\n"
+        "\"Deploy, then \"\"verify\"\"\",DevOps,2,4,,bob\r\n"
+        "\n"
+        "Broken line,ai,7,1,2025-03-01,alice\n"
+        "Tune kernels,hpc,1,6,2025-03-02,alice";
+    ImportOptions options;
+    options.chunkBytes = 16;  // Force several chunks and windows
+    options.chunksPerWindow = 2;
+    options.createUsers = true;
+    options.defaultPassword = "imported";
+    ImportResult csvResult = TaskImporter(pool, options).importText(csv, users);
+    EXPECT_EQ(csvResult.imported, 3u);
+    EXPECT_EQ(csvResult.rejected, 1u);
+    EXPECT_EQ(csvResult.firstRejectedLine, 5u);
+    EXPECT_EQ(csvResult.bytes, csv.size());
+
+    auto alice = users.findUser("alice");
+    ASSERT_NE(alice, nullptr);
+    EXPECT_TRUE(alice->checkPassword("secret"));
+    ASSERT_EQ(alice->getTasks().size(), 2u);
+    TaskId train = alice->getTasks().findByName("Train model");
+    ASSERT_NE(train, TaskStore::npos);
+    EXPECT_EQ(alice->getTasks().kind(train), TaskKind::Ai);
+    EXPECT_EQ(alice->getTasks().priority(train), 3);
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(alice->getTasks().deadline(train)), 1740821400);
+    EXPECT_EQ(alice->getTasks().findByName("Tune kernels"), train + 1);
+
+    auto bob = users.findUser("bob");
+    ASSERT_NE(bob, nullptr);
+    EXPECT_TRUE(bob->checkPassword("imported"));
+    EXPECT_NE(bob->getTasks().findByName("Deploy, then \"verify\""), TaskStore::npos);
+
+    std::string jsonl =
+        "{\"name\":\"Write docs\",\"kind\":\"programming\",\"priority\":1,\"estimatedTime\":2,"
+        "\"deadline\":\"2025-03-01T09:30:00.5Z\",\"owner\":\"bob\",\"extra\":true}\n"
+        "{ \"owner\" : \"carol\", \"estimatedTime\" : 3, \"priority\" : 2, \"kind\" : 1, \"name\" : \"caf\\u00e9 \\\"run\\\"\" }\n"
+        "{\"name\":\"No owner\",\"kind\":\"ai\",\"priority\":1,\"estimatedTime\":1}\n";
+    options.format = ImportFormat::JsonLines;
+    options.createUsers = false;
+    ImportResult jsonResult = TaskImporter(pool, options).importText(jsonl, users);
+    EXPECT_EQ(jsonResult.imported, 1u);
+    EXPECT_EQ(jsonResult.rejected, 2u);  // Missing owner, unknown owner carol
+    EXPECT_EQ(jsonResult.firstRejectedLine, 3u);
+    EXPECT_EQ(bob->getTasks().size(), 2u);
+    EXPECT_EQ(users.findUser("carol"), nullptr);
+
+    options.createUsers = true;
+    std::string path = ::testing::TempDir() + "import_test.jsonl";
+    ASSERT_TRUE(binio::writeFileAtomically(path, jsonl));
+    ImportResult fileResult;
+    ASSERT_TRUE(TaskImporter(pool, options).importFile(path, users, fileResult));
+    EXPECT_EQ(fileResult.imported, 2u);
+    ASSERT_NE(users.findUser("carol"), nullptr);
+    TaskId cafe = users.findUser("carol")->getTasks().findByName("caf\xC3\xA9 \"run\"");
+    ASSERT_NE(cafe, TaskStore::npos);
+    EXPECT_EQ(users.findUser("carol")->getTasks().kind(cafe), TaskKind::Hpc);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(TaskImporter(pool, options).importFile(path, users, fileResult));
+    // Without a password for them, unknown owners are not registered
+    options.format = ImportFormat::Csv;
+    options.defaultPassword.clear();
+    ImportResult noPassword = TaskImporter(pool, options).importText("Audit,devops,2,1,,dave\n", users);
+    EXPECT_EQ(noPassword.imported, 0u);
+    EXPECT_EQ(noPassword.rejected, 1u);
+    EXPECT_EQ(users.findUser("dave"), nullptr);
+}
+
+// checking pipelined requests against a TaskServer over a Unix socket
+TEST(TaskServerTests, PipelinedRequests) {
+    UserManager users;
+    TaskServer server(users);
+    std::string path = ::testing::TempDir() + "task_server_test.sock";
+    ASSERT_TRUE(server.listenUnix(path));
+    std::thread loop([&] { server.run(); });
+
+    TaskClient client;
+    ASSERT_TRUE(client.connectUnix(path));
+    auto deadline = std::chrono::system_clock::from_time_t(1740821400);
+    std::vector<std::uint32_t> ids = {
+        client.sendRegister("alice", "secret"),
+        client.sendRegister("alice", "other"),
+        client.sendAddTask(Task(TaskKind::Ai, "Too early", 1, 1)),
+        client.sendLogin("alice", "wrong"),
+        client.sendLogin("alice", "secret"),
+        client.sendAddTask(Task(TaskKind::Hpc, "Low", 1, 4, deadline)),
+        client.sendAddTask(Task(TaskKind::Ai, "High", 3, 2, deadline)),
+        client.sendAddTask(Task(TaskKind::Devops, "", 2, 2)),
+        client.sendAddTask(Task(TaskKind::Devops, "Priority 7", 7, 2)),
+        client.sendAddTask(Task(TaskKind::Devops, "Negative hours", 2, -5)),
+        client.sendMarkTaskComplete("Missing"),
+        client.sendMarkTaskComplete("Low"),
+        client.sendListTasks()};
+    std::vector<protocol::Status> expected = {
+        protocol::Status::Ok, protocol::Status::AlreadyExists, protocol::Status::NotLoggedIn,
+        protocol::Status::AuthFailed, protocol::Status::Ok, protocol::Status::Ok, protocol::Status::Ok,
+        protocol::Status::BadRequest, protocol::Status::BadRequest, protocol::Status::BadRequest,
+        protocol::Status::NotFound, protocol::Status::Ok, protocol::Status::Ok};
+    ASSERT_TRUE(client.flush());
+
+    TaskClient::Response response;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ASSERT_TRUE(client.receive(response));
+        EXPECT_EQ(response.requestId, ids[i]);
+        EXPECT_EQ(response.status, expected[i]) << "request " << i;
+    }
+    std::vector<RemoteTask> tasks;
+    ASSERT_TRUE(TaskClient::decodeTaskList(response.fields, tasks));
+    ASSERT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(tasks[0].task.name, "High");
+    EXPECT_EQ(tasks[0].task.kind, TaskKind::Ai);
+    EXPECT_EQ(tasks[0].task.deadline, deadline);
+    EXPECT_FALSE(tasks[0].task.isCompleted);
+    EXPECT_EQ(tasks[1].task.name, "Low");
+    EXPECT_TRUE(tasks[1].task.isCompleted);
+
+    // Logins are per connection
+    TaskClient other;
+    ASSERT_TRUE(other.connectUnix(path));
+    EXPECT_EQ(other.listTasks(tasks), protocol::Status::NotLoggedIn);
+    EXPECT_EQ(other.login("alice", "secret"), protocol::Status::Ok);
+    std::uint32_t id = 0;
+    EXPECT_EQ(other.addTask(Task(TaskKind::Programming, "Third", 2, 1), &id), protocol::Status::Ok);
+    EXPECT_EQ(id, 2u);
+
+    // Another file at a socket path is never replaced
+    std::string notSocket = ::testing::TempDir() + "task_server_test.snap";
+    ASSERT_TRUE(binio::writeFileAtomically(notSocket, "snapshot"));
+    TaskServer second(users);
+    EXPECT_FALSE(second.listenUnix(notSocket));
+    EXPECT_TRUE(binio::fileExists(notSocket));
+    std::remove(notSocket.c_str());
+
+    server.stop();
+    loop.join();
+    EXPECT_EQ(server.requestCount(), 16u);
+    ASSERT_NE(users.findUser("alice"), nullptr);
+    EXPECT_EQ(users.findUser("alice")->getTasks().size(), 3u);
+}
+
+// checking that a listing larger than one frame comes back in pages
+TEST(TaskServerTests, ListsLargeUsersInPages) {
+    UserManager users;
+    users.registerUser("alice", "secret");
+    std::vector<Task> batch;
+    for (int i = 0; i < 6000; ++i) {
+        batch.emplace_back(TaskKind::Ai, std::to_string(i) + ": " + std::string(200, 'x'), i % 3 + 1, 1);
+    }
+    users.findUser("alice")->addTasks(batch);  // About 1.4 MiB listed
+
+    TaskServer server(users);
+    std::string path = ::testing::TempDir() + "task_server_pages.sock";
+    ASSERT_TRUE(server.listenUnix(path));
+    std::thread loop([&] { server.run(); });
+
+    TaskClient client;
+    ASSERT_TRUE(client.connectUnix(path));
+    ASSERT_EQ(client.login("alice", "secret"), protocol::Status::Ok);
+    std::vector<RemoteTask> tasks;
+    ASSERT_EQ(client.listTasks(tasks), protocol::Status::Ok);
+    ASSERT_EQ(tasks.size(), batch.size());
+    std::vector<TaskId> expected = users.findUser("alice")->getPriorityIndex().sorted();
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        ASSERT_EQ(tasks[i].id, expected[i]) << "entry " << i;
+    }
+    EXPECT_EQ(tasks[0].task.name, batch[expected[0]].name);
+
+    // An explicit page, resuming after the tenth task
+    RemoteTask tenth = tasks[9];
+    client.sendListTasks(5, &tenth);
+    TaskClient::Response response;
+    ASSERT_TRUE(client.flush());
+    ASSERT_TRUE(client.receive(response));
+    std::uint32_t total = 0;
+    bool more = false;
+    ASSERT_TRUE(TaskClient::decodeTaskList(response.fields, tasks, &total, &more));
+    EXPECT_EQ(total, 6000u);
+    EXPECT_TRUE(more);
+    ASSERT_EQ(tasks.size(), 5u);
+    EXPECT_EQ(tasks[0].id, expected[10]);
+    EXPECT_EQ(tasks[4].id, expected[14]);
+
+    // The last page says nothing follows
+    RemoteTask last;
+    last.id = expected[5997];
+    last.task = users.findUser("alice")->getTasks().get(expected[5997]);
+    client.sendListTasks(0, &last);
+    ASSERT_TRUE(client.flush());
+    ASSERT_TRUE(client.receive(response));
+    ASSERT_TRUE(TaskClient::decodeTaskList(response.fields, tasks, &total, &more));
+    EXPECT_FALSE(more);
+    ASSERT_EQ(tasks.size(), 2u);
+    EXPECT_EQ(tasks[1].id, expected[5999]);
+
+    // A task that cannot fit in any frame is reported instead of cutting the connection
+    users.withUser(users.findUser("alice"), [](User& user) {
+        user.addTask(Task(TaskKind::Ai, std::string(protocol::MaxFrameBytes, 'y'), 3, 1));
+    });
+    EXPECT_EQ(client.listTasks(tasks), protocol::Status::TooLarge);
+    EXPECT_EQ(client.markTaskComplete("0: " + std::string(200, 'x')), protocol::Status::Ok);
+
+    server.stop();
+    loop.join();
+}
+
+// checking scripted commands, including batched adds and error reporting
+TEST(BatchRunnerTests, AppliesScript) {
+    UserManager users;
+    std::string script =
+        "# setup\n"
+        "register alice secret\n"
+        "register alice other\n"
+        "add ai 1 1 - Too early\n"
+        "login alice secret\n"
+        "add hpc 1 4 2025-03-01 Low priority\n"
+        "add AI 3 2 2025-03-01T09:30:00Z  High priority  \n"
+        "add devops 5 2 - Bad priority\n"
+        "\n"
+        "complete Low priority\n"
+        "update 2 - High priority\n"
+        "remove Missing\n"
+        "list\n"
+        "frobnicate\n"
+        "logout\n"
+        "list";
+    std::ostringstream out;
+    BatchResult result = BatchRunner(users).runText(script, out);
+    EXPECT_EQ(result.lines, 16u);
+    EXPECT_EQ(result.commands, 14u);
+    EXPECT_EQ(result.failed, 6u);
+    EXPECT_EQ(result.firstFailedLine, 3u);
+
+    auto alice = users.findUser("alice");
+    ASSERT_NE(alice, nullptr);
+    const TaskStore& tasks = alice->getTasks();
+    ASSERT_EQ(tasks.size(), 2u);
+    TaskId low = tasks.findByName("Low priority");
+    TaskId high = tasks.findByName("High priority");
+    ASSERT_NE(low, TaskStore::npos);
+    ASSERT_NE(high, TaskStore::npos);
+    EXPECT_TRUE(tasks.isCompleted(low));
+    EXPECT_EQ(tasks.priority(high), 2);
+    EXPECT_EQ(tasks.kind(high), TaskKind::Ai);
+
+    std::string output = out.str();
+    EXPECT_NE(output.find("line 3: username already exists\n"), std::string::npos);
+    EXPECT_NE(output.find("line 4: not logged in\n"), std::string::npos);
+    EXPECT_NE(output.find("line 8: expected: add"), std::string::npos);
+    EXPECT_NE(output.find("line 12: task \"Missing\" not found\n"), std::string::npos);
+    EXPECT_NE(output.find("line 14: unknown command \"frobnicate\"\n"), std::string::npos);
+    EXPECT_NE(output.find("line 16: not logged in\n"), std::string::npos);
+    // The listing comes out in priority order, between the errors around it
+    std::size_t listed = output.find("AI Task: High priority | Priority: 2");
+    ASSERT_NE(listed, std::string::npos);
+    EXPECT_LT(output.find("line 12:"), listed);
+    EXPECT_LT(listed, output.find("AI Task: Low priority"));
+    EXPECT_LT(output.find("AI Task: Low priority"), output.find("line 14:"));
+}
+
+// checking that operation counts from several threads are merged, sampled and reset
+TEST(OpStatsTests, RecordsAndMerges) {
+    OpStats::setEnabled(true);
+    OpStats::setSamplingInterval(4);
+    OpStats::reset();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 100; ++i) {
+                OpTimer timer(Operation::CompleteTask);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    UserManager users;
+    users.registerUser("alice", "secret");
+    users.loginUser("alice", "secret");
+    users.loginUser("alice", "wrong");
+
+    StatsSnapshot stats = OpStats::snapshot();
+    EXPECT_EQ(stats[Operation::CompleteTask].count, 400u);
+    EXPECT_EQ(stats[Operation::CompleteTask].samples, 100u);
+    EXPECT_EQ(stats[Operation::RegisterUser].count, 1u);
+    EXPECT_EQ(stats[Operation::Login].count, 2u);
+    EXPECT_EQ(stats[Operation::AddTask].count, 0u);
+    EXPECT_LE(stats[Operation::CompleteTask].percentileNanoseconds(0.5),
+              stats[Operation::CompleteTask].maxNanoseconds());
+
+    std::ostringstream json;
+    stats.writeJson(json);
+    EXPECT_NE(json.str().find("\"complete_task\":{\"count\":400,\"samples\":100,"), std::string::npos);
+
+    // The batch front end reports the same counters and can switch them off
+    std::ostringstream out;
+    BatchResult result = BatchRunner(users).runText("stats reset\nstats off\nlogin alice secret\nstats", out);
+    EXPECT_EQ(result.failed, 0u);
+    EXPECT_FALSE(OpStats::isEnabled());
+    EXPECT_EQ(OpStats::snapshot()[Operation::Login].count, 0u);
+    EXPECT_NE(out.str().find("(recording is off)"), std::string::npos);
+
+    OpStats::setSamplingInterval(OpStats::DefaultSamplingInterval);
+}
+
+// checking that sessions of different users work in parallel, with the log compacting underneath
+TEST(UserManagerTests, ConcurrentSessions) {
+    std::string snapshot = testing::TempDir() + "sessions.snap";
+    std::string logPath = testing::TempDir() + "sessions.log";
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+
+    constexpr int Threads = 8;
+    constexpr int TasksPerThread = 300;
+    constexpr int ImportedTasks = 500;
+    constexpr int ScriptedTasks = 200;
+    MutationLog::Options options;
+    options.compactionBytes = 16 << 10;  // Checkpoint several times during the run
+    {
+        UserManager manager;
+        ASSERT_TRUE(manager.openStorage(snapshot, logPath, options));
+        manager.registerUser("shared", "pw");
+
+        // An import and a batch script add to the shared user alongside the sessions
+        std::string csv = "name,kind,priority,estimatedTime,deadline,owner\n";
+        std::string script = "login shared pw\n";
+        for (int i = 0; i < ImportedTasks; ++i) {
+            csv += "imported " + std::to_string(i) + ",ai,2,1,,shared\n";
+        }
+        for (int i = 0; i < ScriptedTasks; ++i) {
+            script += "add hpc 1 1 - scripted " + std::to_string(i) + "\n";
+            if (i % 50 == 0) {
+                script += "list\n";
+            }
+        }
+        WorkStealingPool pool(2);
+        ImportOptions importOptions;
+        importOptions.chunkBytes = 1024;
+        std::thread importer([&] {
+            EXPECT_EQ(TaskImporter(pool, importOptions).importText(csv, manager).imported,
+                      static_cast<std::size_t>(ImportedTasks));
+        });
+        std::thread scripted([&] {
+            std::ostringstream out;
+            EXPECT_EQ(BatchRunner(manager).runText(script, out).failed, 0u);
+        });
+
+        std::vector<SessionToken> tokens(Threads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < Threads; ++t) {
+            threads.emplace_back([&manager, &tokens, t] {
+                std::string name = "user" + std::to_string(t);
+                manager.registerUser(name, "pw");
+                SessionToken own = manager.openSession(name, "pw");
+                SessionToken shared = manager.openSession("shared", "pw");
+                tokens[t] = own;
+                for (int i = 0; i < TasksPerThread; ++i) {
+                    std::string task = name + " task " + std::to_string(i);
+                    manager.withSession(own, [&](User& user) { user.addTask(Task(TaskKind::Ai, task, 1 + i % 3, 1)); });
+                    manager.withSession(shared, [&](User& user) { user.addTask(Task(TaskKind::Hpc, task, 2, 1)); });
+                }
+                manager.withSession(own, [&](User& user) { user.markTaskComplete(name + " task 0"); });
+                EXPECT_TRUE(manager.closeSession(shared));
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        importer.join();
+        scripted.join();
+
+        EXPECT_EQ(manager.sessionCount(), static_cast<std::size_t>(Threads));
+        std::sort(tokens.begin(), tokens.end());
+        EXPECT_EQ(std::unique(tokens.begin(), tokens.end()), tokens.end());
+        EXPECT_EQ(manager.sessionUser(tokens[0])->getTasks().size(), static_cast<std::size_t>(TasksPerThread));
+
+        EXPECT_TRUE(manager.closeSession(tokens[0]));
+        EXPECT_FALSE(manager.closeSession(tokens[0]));
+        EXPECT_FALSE(manager.withSession(tokens[0], [](User&) { FAIL(); }));
+        EXPECT_EQ(manager.openSession("shared", "wrong"), SessionTable::NoSession);
+        manager.logoutUser();  // The batch script logged in
+    }
+
+    // Everything survives the checkpoints taken mid-run
+    UserManager restored;
+    ASSERT_TRUE(restored.openStorage(snapshot, logPath, options));
+    EXPECT_EQ(restored.userCount(), static_cast<std::size_t>(Threads + 1));
+    EXPECT_EQ(restored.findUser("shared")->getTasks().size(),
+              static_cast<std::size_t>(Threads * TasksPerThread + ImportedTasks + ScriptedTasks));
+    for (int t = 0; t < Threads; ++t) {
+        std::string name = "user" + std::to_string(t);
+        const TaskStore& tasks = restored.findUser(name)->getTasks();
+        EXPECT_EQ(tasks.size(), static_cast<std::size_t>(TasksPerThread));
+        EXPECT_TRUE(tasks.isCompleted(tasks.findByName(name + " task 0")));
+    }
+
+    std::remove(snapshot.c_str());
+    std::remove(logPath.c_str());
+}